@@ -102,6 +102,36 @@ static rt_bool_t perform_calibration(struct calibration_session *session,calcula
     return RT_TRUE;
 }
 
+/* post the command to calibration window, by pointer from event pool */
+static void _calibration_command_post(rt_int32_t command_id)
+{
+    struct rtgui_event_command *ecmd;
+    struct rtgui_event_command command;
+
+#ifdef RTGUI_USING_EVENT_POOL
+    ecmd = (struct rtgui_event_command *)rtgui_event_alloc(sizeof(struct rtgui_event_command));
+    if (ecmd == RT_NULL)
+        ecmd = &command;
+#else
+    ecmd = &command;
+#endif
+
+    RTGUI_EVENT_COMMAND_INIT(ecmd);
+    ecmd->wid = calibration_ptr->win;
+    ecmd->type = 0;
+    ecmd->command_id = command_id;
+    ecmd->command_string[0] = '\0';
+
+#ifdef RTGUI_USING_EVENT_POOL
+    if (ecmd != &command)
+    {
+        rtgui_send_pooled(calibration_ptr->app, &ecmd->parent);
+        return;
+    }
+#endif
+    rtgui_send(calibration_ptr->app, &ecmd->parent, sizeof(struct rtgui_event_command));
+}
+
 static void _calibration_data_post(rt_uint16_t x, rt_uint16_t y)
 {
     if (calibration_ptr == RT_NULL)
@@ -141,10 +171,6 @@ static void _calibration_data_post(rt_uint16_t x, rt_uint16_t y)
         /* calibration done */
     {
         rt_uint8_t i;
-        struct rtgui_event_command ecmd;
-        RTGUI_EVENT_COMMAND_INIT(&ecmd);
-        ecmd.wid = calibration_ptr->win;
-        ecmd.command_id = TOUCH_WIN_CLOSE;
         calibration_ptr->data.xfb[4] = (calibration_ptr->width >> 1);
         calibration_ptr->data.yfb[4] = (calibration_ptr->height >> 1);
         calibration_ptr->data.x[4] = x;
@@ -157,7 +183,7 @@ static void _calibration_data_post(rt_uint16_t x, rt_uint16_t y)
 		{
             rt_kprintf("touch calibration failure,please try again.\n");
         }
-        rtgui_send(calibration_ptr->app, &ecmd.parent, sizeof(struct rtgui_event_command));
+        _calibration_command_post(TOUCH_WIN_CLOSE);
     }
     calibration_ptr->step = 0;
     return;
@@ -166,14 +192,7 @@ static void _calibration_data_post(rt_uint16_t x, rt_uint16_t y)
     calibration_ptr->step++;
 
     /* post command event */
-    {
-        struct rtgui_event_command ecmd;
-        RTGUI_EVENT_COMMAND_INIT(&ecmd);
-        ecmd.wid = calibration_ptr->win;
-        ecmd.command_id = TOUCH_WIN_UPDATE;
-
-        rtgui_send(calibration_ptr->app, &ecmd.parent, sizeof(struct rtgui_event_command));
-    }
+    _calibration_command_post(TOUCH_WIN_UPDATE);
 }
 
 static rt_uint16_t _calibrate_x(rt_uint16_t adc_x, rt_uint16_t adc_y)
@@ -49,6 +49,23 @@
 #include <rtgui/blit.h>
 #include <rtgui/color.h>
 
+#ifdef RTGUI_USING_BLIT_SIMD
+#if defined(__SSE2__)
+#define RTGUI_BLIT_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) && (__GNUC__ >= 5)
+#define RTGUI_BLIT_SSSE3
+#define RTGUI_BLIT_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define RTGUI_BLIT_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
 /* Lookup tables to expand partial bytes to the full 0..255 range */
 
 static const rt_uint8_t lookup_0[] = {
@@ -213,139 +230,6 @@ static void rtgui_blit_line_1_3(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int li
 #define HI  1
 #define LO  0
 
-/* Special optimized blit for RGB 5-6-5 --> RGBA 8-8-8-8 */
-static const rt_uint32_t RGB565_RGBA8888_LUT[512] =
-{
-    0x000000ff, 0x00000000, 0x000008ff, 0x00200000,
-    0x000010ff, 0x00400000, 0x000018ff, 0x00610000,
-    0x000020ff, 0x00810000, 0x000029ff, 0x00a10000,
-    0x000031ff, 0x00c20000, 0x000039ff, 0x00e20000,
-    0x000041ff, 0x08000000, 0x00004aff, 0x08200000,
-    0x000052ff, 0x08400000, 0x00005aff, 0x08610000,
-    0x000062ff, 0x08810000, 0x00006aff, 0x08a10000,
-    0x000073ff, 0x08c20000, 0x00007bff, 0x08e20000,
-    0x000083ff, 0x10000000, 0x00008bff, 0x10200000,
-    0x000094ff, 0x10400000, 0x00009cff, 0x10610000,
-    0x0000a4ff, 0x10810000, 0x0000acff, 0x10a10000,
-    0x0000b4ff, 0x10c20000, 0x0000bdff, 0x10e20000,
-    0x0000c5ff, 0x18000000, 0x0000cdff, 0x18200000,
-    0x0000d5ff, 0x18400000, 0x0000deff, 0x18610000,
-    0x0000e6ff, 0x18810000, 0x0000eeff, 0x18a10000,
-    0x0000f6ff, 0x18c20000, 0x0000ffff, 0x18e20000,
-    0x000400ff, 0x20000000, 0x000408ff, 0x20200000,
-    0x000410ff, 0x20400000, 0x000418ff, 0x20610000,
-    0x000420ff, 0x20810000, 0x000429ff, 0x20a10000,
-    0x000431ff, 0x20c20000, 0x000439ff, 0x20e20000,
-    0x000441ff, 0x29000000, 0x00044aff, 0x29200000,
-    0x000452ff, 0x29400000, 0x00045aff, 0x29610000,
-    0x000462ff, 0x29810000, 0x00046aff, 0x29a10000,
-    0x000473ff, 0x29c20000, 0x00047bff, 0x29e20000,
-    0x000483ff, 0x31000000, 0x00048bff, 0x31200000,
-    0x000494ff, 0x31400000, 0x00049cff, 0x31610000,
-    0x0004a4ff, 0x31810000, 0x0004acff, 0x31a10000,
-    0x0004b4ff, 0x31c20000, 0x0004bdff, 0x31e20000,
-    0x0004c5ff, 0x39000000, 0x0004cdff, 0x39200000,
-    0x0004d5ff, 0x39400000, 0x0004deff, 0x39610000,
-    0x0004e6ff, 0x39810000, 0x0004eeff, 0x39a10000,
-    0x0004f6ff, 0x39c20000, 0x0004ffff, 0x39e20000,
-    0x000800ff, 0x41000000, 0x000808ff, 0x41200000,
-    0x000810ff, 0x41400000, 0x000818ff, 0x41610000,
-    0x000820ff, 0x41810000, 0x000829ff, 0x41a10000,
-    0x000831ff, 0x41c20000, 0x000839ff, 0x41e20000,
-    0x000841ff, 0x4a000000, 0x00084aff, 0x4a200000,
-    0x000852ff, 0x4a400000, 0x00085aff, 0x4a610000,
-    0x000862ff, 0x4a810000, 0x00086aff, 0x4aa10000,
-    0x000873ff, 0x4ac20000, 0x00087bff, 0x4ae20000,
-    0x000883ff, 0x52000000, 0x00088bff, 0x52200000,
-    0x000894ff, 0x52400000, 0x00089cff, 0x52610000,
-    0x0008a4ff, 0x52810000, 0x0008acff, 0x52a10000,
-    0x0008b4ff, 0x52c20000, 0x0008bdff, 0x52e20000,
-    0x0008c5ff, 0x5a000000, 0x0008cdff, 0x5a200000,
-    0x0008d5ff, 0x5a400000, 0x0008deff, 0x5a610000,
-    0x0008e6ff, 0x5a810000, 0x0008eeff, 0x5aa10000,
-    0x0008f6ff, 0x5ac20000, 0x0008ffff, 0x5ae20000,
-    0x000c00ff, 0x62000000, 0x000c08ff, 0x62200000,
-    0x000c10ff, 0x62400000, 0x000c18ff, 0x62610000,
-    0x000c20ff, 0x62810000, 0x000c29ff, 0x62a10000,
-    0x000c31ff, 0x62c20000, 0x000c39ff, 0x62e20000,
-    0x000c41ff, 0x6a000000, 0x000c4aff, 0x6a200000,
-    0x000c52ff, 0x6a400000, 0x000c5aff, 0x6a610000,
-    0x000c62ff, 0x6a810000, 0x000c6aff, 0x6aa10000,
-    0x000c73ff, 0x6ac20000, 0x000c7bff, 0x6ae20000,
-    0x000c83ff, 0x73000000, 0x000c8bff, 0x73200000,
-    0x000c94ff, 0x73400000, 0x000c9cff, 0x73610000,
-    0x000ca4ff, 0x73810000, 0x000cacff, 0x73a10000,
-    0x000cb4ff, 0x73c20000, 0x000cbdff, 0x73e20000,
-    0x000cc5ff, 0x7b000000, 0x000ccdff, 0x7b200000,
-    0x000cd5ff, 0x7b400000, 0x000cdeff, 0x7b610000,
-    0x000ce6ff, 0x7b810000, 0x000ceeff, 0x7ba10000,
-    0x000cf6ff, 0x7bc20000, 0x000cffff, 0x7be20000,
-    0x001000ff, 0x83000000, 0x001008ff, 0x83200000,
-    0x001010ff, 0x83400000, 0x001018ff, 0x83610000,
-    0x001020ff, 0x83810000, 0x001029ff, 0x83a10000,
-    0x001031ff, 0x83c20000, 0x001039ff, 0x83e20000,
-    0x001041ff, 0x8b000000, 0x00104aff, 0x8b200000,
-    0x001052ff, 0x8b400000, 0x00105aff, 0x8b610000,
-    0x001062ff, 0x8b810000, 0x00106aff, 0x8ba10000,
-    0x001073ff, 0x8bc20000, 0x00107bff, 0x8be20000,
-    0x001083ff, 0x94000000, 0x00108bff, 0x94200000,
-    0x001094ff, 0x94400000, 0x00109cff, 0x94610000,
-    0x0010a4ff, 0x94810000, 0x0010acff, 0x94a10000,
-    0x0010b4ff, 0x94c20000, 0x0010bdff, 0x94e20000,
-    0x0010c5ff, 0x9c000000, 0x0010cdff, 0x9c200000,
-    0x0010d5ff, 0x9c400000, 0x0010deff, 0x9c610000,
-    0x0010e6ff, 0x9c810000, 0x0010eeff, 0x9ca10000,
-    0x0010f6ff, 0x9cc20000, 0x0010ffff, 0x9ce20000,
-    0x001400ff, 0xa4000000, 0x001408ff, 0xa4200000,
-    0x001410ff, 0xa4400000, 0x001418ff, 0xa4610000,
-    0x001420ff, 0xa4810000, 0x001429ff, 0xa4a10000,
-    0x001431ff, 0xa4c20000, 0x001439ff, 0xa4e20000,
-    0x001441ff, 0xac000000, 0x00144aff, 0xac200000,
-    0x001452ff, 0xac400000, 0x00145aff, 0xac610000,
-    0x001462ff, 0xac810000, 0x00146aff, 0xaca10000,
-    0x001473ff, 0xacc20000, 0x00147bff, 0xace20000,
-    0x001483ff, 0xb4000000, 0x00148bff, 0xb4200000,
-    0x001494ff, 0xb4400000, 0x00149cff, 0xb4610000,
-    0x0014a4ff, 0xb4810000, 0x0014acff, 0xb4a10000,
-    0x0014b4ff, 0xb4c20000, 0x0014bdff, 0xb4e20000,
-    0x0014c5ff, 0xbd000000, 0x0014cdff, 0xbd200000,
-    0x0014d5ff, 0xbd400000, 0x0014deff, 0xbd610000,
-    0x0014e6ff, 0xbd810000, 0x0014eeff, 0xbda10000,
-    0x0014f6ff, 0xbdc20000, 0x0014ffff, 0xbde20000,
-    0x001800ff, 0xc5000000, 0x001808ff, 0xc5200000,
-    0x001810ff, 0xc5400000, 0x001818ff, 0xc5610000,
-    0x001820ff, 0xc5810000, 0x001829ff, 0xc5a10000,
-    0x001831ff, 0xc5c20000, 0x001839ff, 0xc5e20000,
-    0x001841ff, 0xcd000000, 0x00184aff, 0xcd200000,
-    0x001852ff, 0xcd400000, 0x00185aff, 0xcd610000,
-    0x001862ff, 0xcd810000, 0x00186aff, 0xcda10000,
-    0x001873ff, 0xcdc20000, 0x00187bff, 0xcde20000,
-    0x001883ff, 0xd5000000, 0x00188bff, 0xd5200000,
-    0x001894ff, 0xd5400000, 0x00189cff, 0xd5610000,
-    0x0018a4ff, 0xd5810000, 0x0018acff, 0xd5a10000,
-    0x0018b4ff, 0xd5c20000, 0x0018bdff, 0xd5e20000,
-    0x0018c5ff, 0xde000000, 0x0018cdff, 0xde200000,
-    0x0018d5ff, 0xde400000, 0x0018deff, 0xde610000,
-    0x0018e6ff, 0xde810000, 0x0018eeff, 0xdea10000,
-    0x0018f6ff, 0xdec20000, 0x0018ffff, 0xdee20000,
-    0x001c00ff, 0xe6000000, 0x001c08ff, 0xe6200000,
-    0x001c10ff, 0xe6400000, 0x001c18ff, 0xe6610000,
-    0x001c20ff, 0xe6810000, 0x001c29ff, 0xe6a10000,
-    0x001c31ff, 0xe6c20000, 0x001c39ff, 0xe6e20000,
-    0x001c41ff, 0xee000000, 0x001c4aff, 0xee200000,
-    0x001c52ff, 0xee400000, 0x001c5aff, 0xee610000,
-    0x001c62ff, 0xee810000, 0x001c6aff, 0xeea10000,
-    0x001c73ff, 0xeec20000, 0x001c7bff, 0xeee20000,
-    0x001c83ff, 0xf6000000, 0x001c8bff, 0xf6200000,
-    0x001c94ff, 0xf6400000, 0x001c9cff, 0xf6610000,
-    0x001ca4ff, 0xf6810000, 0x001cacff, 0xf6a10000,
-    0x001cb4ff, 0xf6c20000, 0x001cbdff, 0xf6e20000,
-    0x001cc5ff, 0xff000000, 0x001ccdff, 0xff200000,
-    0x001cd5ff, 0xff400000, 0x001cdeff, 0xff610000,
-    0x001ce6ff, 0xff810000, 0x001ceeff, 0xffa10000,
-    0x001cf6ff, 0xffc20000, 0x001cffff, 0xffe20000,
-};
-
 /* Special optimized blit for RGB 5-6-5 --> ARGB 8-8-8-8 */
 static const rt_uint32_t RGB565_ARGB8888_LUT[512] = {
     0x00000000, 0xff000000, 0x00000008, 0xff002000,
@@ -478,20 +362,20 @@ static const rt_uint32_t RGB565_ARGB8888_LUT[512] = {
     0x00001cf6, 0xffffc200, 0x00001cff, 0xffffe200
 };
 
+/* convert 2bpp to 3bpp */
 static void rtgui_blit_line_2_3(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
 {
-    rt_uint16_t *src;
-    rt_uint32_t *dst;
-
-    src = (rt_uint16_t *)src_ptr;
-    dst = (rt_uint32_t *)dst_ptr;
+    rt_uint16_t pixel;
 
     line = line / 2;
     while (line)
     {
-        *dst++ = RGB565_RGBA8888_LUT[src[LO] * 2] + RGB565_RGBA8888_LUT[src[HI] * 2 + 1];
-        line--;
-        src ++;
+        pixel = *(rt_uint16_t *)src_ptr;
+        *dst_ptr++ = lookup_3[pixel & 0x1F];
+        *dst_ptr++ = lookup_2[(pixel >> 5) & 0x3F];
+        *dst_ptr++ = lookup_3[pixel >> 11];
+        src_ptr += 2;
+        line --;
     }
 }
 
@@ -518,25 +402,439 @@ static void rtgui_blit_line_1_4(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int li
 {
 }
 
+/* convert 2bpp to 4bpp */
 static void rtgui_blit_line_2_4(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
 {
+    rt_uint16_t *src;
+    rt_uint32_t *dst;
+
+    src = (rt_uint16_t *)src_ptr;
+    dst = (rt_uint32_t *)dst_ptr;
+
+    line = line / 2;
+    while (line)
+    {
+        *dst++ = 0xFF000000 | (lookup_3[*src >> 11] << 16) |
+                 (lookup_2[(*src >> 5) & 0x3F] << 8) | lookup_3[*src & 0x1F];
+        src ++;
+        line --;
+    }
 }
 
 /* convert 3bpp to 4bpp */
 static void rtgui_blit_line_3_4(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
 {
-    line = line / 4;
+    line = line / 3;
     while (line)
     {
         *dst_ptr++ = *src_ptr++;
         *dst_ptr++ = *src_ptr++;
         *dst_ptr++ = *src_ptr++;
-        *dst_ptr++ = 0;
+        *dst_ptr++ = 0xFF;
         line --;
     }
 }
 
-static const rtgui_blit_line_func _blit_table[5][5] =
+#ifdef RTGUI_BLIT_SSE2
+/*
+ * SSE2 converters. The 5/6 bits components are expanded with mulhi to the
+ * same value of rtgui_blit_expand_byte: (v << 8) * 2106 >> 16 for 5 bits and
+ * (v << 5) * 8290 >> 16 for 6 bits. The tail of line is done by generic one.
+ */
+#define _SSE2_RGB565_EXPAND(p, r, g, b)                                         \
+do {                                                                            \
+    r = _mm_mulhi_epu16(_mm_and_si128(_mm_srli_epi16(p, 3),                     \
+                                      _mm_set1_epi16(0x1F00)),                  \
+                        _mm_set1_epi16(2106));                                  \
+    g = _mm_mulhi_epu16(_mm_and_si128(p, _mm_set1_epi16(0x07E0)),               \
+                        _mm_set1_epi16(8290));                                  \
+    b = _mm_mulhi_epu16(_mm_and_si128(_mm_slli_epi16(p, 8),                     \
+                                      _mm_set1_epi16(0x1F00)),                  \
+                        _mm_set1_epi16(2106));                                  \
+} while (0)
+
+/* 4 ARGB8888 pixels to 4 RGB565 pixels in the low 16 bits of each 32 bits */
+#define _SSE2_ARGB8888_TO_565(p)                                                \
+    _mm_or_si128(_mm_or_si128(                                                  \
+        _mm_and_si128(_mm_srli_epi32(p, 8), _mm_set1_epi32(0xF800)),            \
+        _mm_and_si128(_mm_srli_epi32(p, 5), _mm_set1_epi32(0x07E0))),           \
+        _mm_and_si128(_mm_srli_epi32(p, 3), _mm_set1_epi32(0x001F)))
+
+/* sign extend the low 16 bits, so packs_epi32 does not saturate them */
+#define _SSE2_PACK_565(a, b)                                                    \
+    _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),                  \
+                    _mm_srai_epi32(_mm_slli_epi32(b, 16), 16))
+
+static void rtgui_blit_line_2_4_sse2(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
+{
+    int n = line / 2;
+    __m128i p, r, g, b, bg, ra;
+
+    for (; n >= 8; n -= 8)
+    {
+        p = _mm_loadu_si128((__m128i *)src_ptr);
+        _SSE2_RGB565_EXPAND(p, r, g, b);
+
+        bg = _mm_or_si128(b, _mm_slli_epi16(g, 8));
+        ra = _mm_or_si128(r, _mm_set1_epi16((short)0xFF00));
+        _mm_storeu_si128((__m128i *)dst_ptr, _mm_unpacklo_epi16(bg, ra));
+        _mm_storeu_si128((__m128i *)(dst_ptr + 16), _mm_unpackhi_epi16(bg, ra));
+
+        src_ptr += 16;
+        dst_ptr += 32;
+    }
+
+    rtgui_blit_line_2_4(dst_ptr, src_ptr, n * 2);
+}
+
+static void rtgui_blit_line_4_2_sse2(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
+{
+    int n = line / 4;
+    __m128i p0, p1;
+
+    for (; n >= 8; n -= 8)
+    {
+        p0 = _mm_loadu_si128((__m128i *)src_ptr);
+        p1 = _mm_loadu_si128((__m128i *)(src_ptr + 16));
+        p0 = _SSE2_ARGB8888_TO_565(p0);
+        p1 = _SSE2_ARGB8888_TO_565(p1);
+        _mm_storeu_si128((__m128i *)dst_ptr, _SSE2_PACK_565(p0, p1));
+
+        src_ptr += 32;
+        dst_ptr += 16;
+    }
+
+    rtgui_blit_line_4_2(dst_ptr, src_ptr, n * 4);
+}
+
+#ifdef RTGUI_BLIT_AVX2
+/*
+ * AVX2 converters of the 16 and 32 bits formats, checked on the cpu at run
+ * time.
+ */
+#define _AVX2_TARGET    __attribute__((target("avx2")))
+
+static _AVX2_TARGET void rtgui_blit_line_2_4_avx2(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
+{
+    int n = line / 2;
+    __m256i p, r, g, b, bg, ra, lo, hi;
+
+    for (; n >= 16; n -= 16)
+    {
+        p = _mm256_loadu_si256((__m256i *)src_ptr);
+        r = _mm256_mulhi_epu16(_mm256_and_si256(_mm256_srli_epi16(p, 3),
+                                                _mm256_set1_epi16(0x1F00)),
+                               _mm256_set1_epi16(2106));
+        g = _mm256_mulhi_epu16(_mm256_and_si256(p, _mm256_set1_epi16(0x07E0)),
+                               _mm256_set1_epi16(8290));
+        b = _mm256_mulhi_epu16(_mm256_and_si256(_mm256_slli_epi16(p, 8),
+                                                _mm256_set1_epi16(0x1F00)),
+                               _mm256_set1_epi16(2106));
+
+        bg = _mm256_or_si256(b, _mm256_slli_epi16(g, 8));
+        ra = _mm256_or_si256(r, _mm256_set1_epi16((short)0xFF00));
+        /* unpack works in each 128 bits lane */
+        lo = _mm256_unpacklo_epi16(bg, ra);
+        hi = _mm256_unpackhi_epi16(bg, ra);
+        _mm256_storeu_si256((__m256i *)dst_ptr, _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256((__m256i *)(dst_ptr + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+
+        src_ptr += 32;
+        dst_ptr += 64;
+    }
+
+    rtgui_blit_line_2_4_sse2(dst_ptr, src_ptr, n * 2);
+}
+
+static _AVX2_TARGET void rtgui_blit_line_4_2_avx2(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
+{
+    int n = line / 4;
+    __m256i p0, p1;
+
+    for (; n >= 16; n -= 16)
+    {
+        p0 = _mm256_loadu_si256((__m256i *)src_ptr);
+        p1 = _mm256_loadu_si256((__m256i *)(src_ptr + 32));
+        p0 = _mm256_or_si256(_mm256_or_si256(
+                 _mm256_and_si256(_mm256_srli_epi32(p0, 8), _mm256_set1_epi32(0xF800)),
+                 _mm256_and_si256(_mm256_srli_epi32(p0, 5), _mm256_set1_epi32(0x07E0))),
+                 _mm256_and_si256(_mm256_srli_epi32(p0, 3), _mm256_set1_epi32(0x001F)));
+        p1 = _mm256_or_si256(_mm256_or_si256(
+                 _mm256_and_si256(_mm256_srli_epi32(p1, 8), _mm256_set1_epi32(0xF800)),
+                 _mm256_and_si256(_mm256_srli_epi32(p1, 5), _mm256_set1_epi32(0x07E0))),
+                 _mm256_and_si256(_mm256_srli_epi32(p1, 3), _mm256_set1_epi32(0x001F)));
+        p0 = _mm256_packus_epi32(p0, p1);
+        /* packus works in each 128 bits lane */
+        _mm256_storeu_si256((__m256i *)dst_ptr, _mm256_permute4x64_epi64(p0, 0xD8));
+
+        src_ptr += 64;
+        dst_ptr += 32;
+    }
+
+    rtgui_blit_line_4_2_sse2(dst_ptr, src_ptr, n * 4);
+}
+#endif /* RTGUI_BLIT_AVX2 */
+
+#ifdef RTGUI_BLIT_SSSE3
+/*
+ * SSSE3 converters of the 24 bits formats, checked on the cpu at run time.
+ * They use the byte shuffle and store 16 bytes for each 12 bytes, so there
+ * must be some pixels left behind the store.
+ */
+#define _SSSE3_TARGET   __attribute__((target("ssse3")))
+
+static _SSSE3_TARGET void rtgui_blit_line_4_3_ssse3(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
+{
+    int n = line / 4;
+    __m128i p;
+    const __m128i mask = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14,
+                                       -1, -1, -1, -1);
+
+    for (; n >= 6; n -= 4)
+    {
+        p = _mm_loadu_si128((__m128i *)src_ptr);
+        _mm_storeu_si128((__m128i *)dst_ptr, _mm_shuffle_epi8(p, mask));
+
+        src_ptr += 16;
+        dst_ptr += 12;
+    }
+
+    rtgui_blit_line_4_3(dst_ptr, src_ptr, n * 4);
+}
+
+static _SSSE3_TARGET void rtgui_blit_line_3_4_ssse3(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
+{
+    int n = line / 3;
+    __m128i p;
+    const __m128i mask = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1,
+                                       6, 7, 8, -1, 9, 10, 11, -1);
+
+    for (; n >= 6; n -= 4)
+    {
+        p = _mm_loadu_si128((__m128i *)src_ptr);
+        p = _mm_or_si128(_mm_shuffle_epi8(p, mask), _mm_set1_epi32(0xFF000000));
+        _mm_storeu_si128((__m128i *)dst_ptr, p);
+
+        src_ptr += 12;
+        dst_ptr += 16;
+    }
+
+    rtgui_blit_line_3_4(dst_ptr, src_ptr, n * 3);
+}
+
+static _SSSE3_TARGET void rtgui_blit_line_2_3_ssse3(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
+{
+    int n = line / 2;
+    __m128i p, r, g, b, bg;
+    const __m128i mask = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14,
+                                       -1, -1, -1, -1);
+
+    for (; n >= 10; n -= 8)
+    {
+        p = _mm_loadu_si128((__m128i *)src_ptr);
+        _SSE2_RGB565_EXPAND(p, r, g, b);
+
+        bg = _mm_or_si128(b, _mm_slli_epi16(g, 8));
+        _mm_storeu_si128((__m128i *)dst_ptr,
+                         _mm_shuffle_epi8(_mm_unpacklo_epi16(bg, r), mask));
+        _mm_storeu_si128((__m128i *)(dst_ptr + 12),
+                         _mm_shuffle_epi8(_mm_unpackhi_epi16(bg, r), mask));
+
+        src_ptr += 16;
+        dst_ptr += 24;
+    }
+
+    rtgui_blit_line_2_3(dst_ptr, src_ptr, n * 2);
+}
+
+static _SSSE3_TARGET void rtgui_blit_line_3_2_ssse3(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
+{
+    int n = line / 3;
+    __m128i p0, p1;
+    const __m128i mask = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1,
+                                       6, 7, 8, -1, 9, 10, 11, -1);
+
+    for (; n >= 10; n -= 8)
+    {
+        p0 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *)src_ptr), mask);
+        p1 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *)(src_ptr + 12)), mask);
+        p0 = _SSE2_ARGB8888_TO_565(p0);
+        p1 = _SSE2_ARGB8888_TO_565(p1);
+        _mm_storeu_si128((__m128i *)dst_ptr, _SSE2_PACK_565(p0, p1));
+
+        src_ptr += 24;
+        dst_ptr += 16;
+    }
+
+    rtgui_blit_line_3_2(dst_ptr, src_ptr, n * 3);
+}
+#endif /* RTGUI_BLIT_SSSE3 */
+#endif /* RTGUI_BLIT_SSE2 */
+
+#ifdef RTGUI_BLIT_NEON
+/*
+ * NEON converters. The interleaved load and store split the 24/32 bits
+ * pixels into the planes of components.
+ */
+static uint8x8x3_t _neon_rgb565_expand(uint16x8_t p)
+{
+    uint8x8x3_t c;
+    uint16x8_t g;
+
+    /* 5 bits: v * 2106 >> 8, 6 bits: (v << 5) * 8290 >> 16 */
+    c.val[2] = vshrn_n_u16(vmulq_n_u16(vshrq_n_u16(p, 11), 2106), 8);
+    g = vandq_u16(p, vdupq_n_u16(0x07E0));
+    c.val[1] = vmovn_u16(vcombine_u16(
+                   vshrn_n_u32(vmull_n_u16(vget_low_u16(g), 8290), 16),
+                   vshrn_n_u32(vmull_n_u16(vget_high_u16(g), 8290), 16)));
+    c.val[0] = vshrn_n_u16(vmulq_n_u16(vandq_u16(p, vdupq_n_u16(0x001F)), 2106), 8);
+
+    return c;
+}
+
+static uint16x8_t _neon_rgb565_pack(uint8x8_t r, uint8x8_t g, uint8x8_t b)
+{
+    uint16x8_t p;
+
+    p = vshll_n_u8(r, 8);
+    p = vsriq_n_u16(p, vshll_n_u8(g, 8), 5);
+    p = vsriq_n_u16(p, vshll_n_u8(b, 8), 11);
+
+    return p;
+}
+
+static void rtgui_blit_line_2_4_neon(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
+{
+    int n = line / 2;
+    uint8x8x3_t c;
+    uint8x8x4_t d;
+
+    d.val[3] = vdup_n_u8(0xFF);
+    for (; n >= 8; n -= 8)
+    {
+        c = _neon_rgb565_expand(vld1q_u16((rt_uint16_t *)src_ptr));
+        d.val[0] = c.val[0];
+        d.val[1] = c.val[1];
+        d.val[2] = c.val[2];
+        vst4_u8(dst_ptr, d);
+
+        src_ptr += 16;
+        dst_ptr += 32;
+    }
+
+    rtgui_blit_line_2_4(dst_ptr, src_ptr, n * 2);
+}
+
+static void rtgui_blit_line_2_3_neon(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
+{
+    int n = line / 2;
+
+    for (; n >= 8; n -= 8)
+    {
+        vst3_u8(dst_ptr, _neon_rgb565_expand(vld1q_u16((rt_uint16_t *)src_ptr)));
+
+        src_ptr += 16;
+        dst_ptr += 24;
+    }
+
+    rtgui_blit_line_2_3(dst_ptr, src_ptr, n * 2);
+}
+
+static void rtgui_blit_line_4_2_neon(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
+{
+    int n = line / 4;
+    uint8x8x4_t c;
+
+    for (; n >= 8; n -= 8)
+    {
+        c = vld4_u8(src_ptr);
+        vst1q_u16((rt_uint16_t *)dst_ptr, _neon_rgb565_pack(c.val[2], c.val[1], c.val[0]));
+
+        src_ptr += 32;
+        dst_ptr += 16;
+    }
+
+    rtgui_blit_line_4_2(dst_ptr, src_ptr, n * 4);
+}
+
+static void rtgui_blit_line_3_2_neon(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
+{
+    int n = line / 3;
+    uint8x8x3_t c;
+
+    for (; n >= 8; n -= 8)
+    {
+        c = vld3_u8(src_ptr);
+        vst1q_u16((rt_uint16_t *)dst_ptr, _neon_rgb565_pack(c.val[2], c.val[1], c.val[0]));
+
+        src_ptr += 24;
+        dst_ptr += 16;
+    }
+
+    rtgui_blit_line_3_2(dst_ptr, src_ptr, n * 3);
+}
+
+static void rtgui_blit_line_4_3_neon(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
+{
+    int n = line / 4;
+    uint8x8x3_t d;
+    uint8x8x4_t c;
+
+    for (; n >= 8; n -= 8)
+    {
+        c = vld4_u8(src_ptr);
+        d.val[0] = c.val[0];
+        d.val[1] = c.val[1];
+        d.val[2] = c.val[2];
+        vst3_u8(dst_ptr, d);
+
+        src_ptr += 32;
+        dst_ptr += 24;
+    }
+
+    rtgui_blit_line_4_3(dst_ptr, src_ptr, n * 4);
+}
+
+static void rtgui_blit_line_3_4_neon(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
+{
+    int n = line / 3;
+    uint8x8x3_t c;
+    uint8x8x4_t d;
+
+    d.val[3] = vdup_n_u8(0xFF);
+    for (; n >= 8; n -= 8)
+    {
+        c = vld3_u8(src_ptr);
+        d.val[0] = c.val[0];
+        d.val[1] = c.val[1];
+        d.val[2] = c.val[2];
+        vst4_u8(dst_ptr, d);
+
+        src_ptr += 24;
+        dst_ptr += 32;
+    }
+
+    rtgui_blit_line_3_4(dst_ptr, src_ptr, n * 3);
+}
+#endif /* RTGUI_BLIT_NEON */
+
+/* the converters in C, which are used as default */
+static const rtgui_blit_line_func _blit_table_generic[5][5] =
+{
+    /* 0_0, 1_0, 2_0, 3_0, 4_0 */
+    {RT_NULL, RT_NULL, RT_NULL, RT_NULL, RT_NULL },
+    /* 0_1, 1_1, 2_1, 3_1, 4_1 */
+    {RT_NULL, rtgui_blit_line_direct, rtgui_blit_line_2_1, rtgui_blit_line_3_1, rtgui_blit_line_4_1 },
+    /* 0_2, 1_2, 2_2, 3_2, 4_2 */
+    {RT_NULL, rtgui_blit_line_1_2, rtgui_blit_line_direct, rtgui_blit_line_3_2, rtgui_blit_line_4_2 },
+    /* 0_3, 1_3, 2_3, 3_3, 4_3 */
+    {RT_NULL, rtgui_blit_line_1_3, rtgui_blit_line_2_3, rtgui_blit_line_direct, rtgui_blit_line_4_3 },
+    /* 0_4, 1_4, 2_4, 3_4, 4_4 */
+    {RT_NULL, rtgui_blit_line_1_4, rtgui_blit_line_2_4, rtgui_blit_line_3_4, rtgui_blit_line_direct },
+};
+
+/* the SIMD converters are installed by rtgui_blit_line_init */
+static rtgui_blit_line_func _blit_table[5][5] =
 {
     /* 0_0, 1_0, 2_0, 3_0, 4_0 */
     {RT_NULL, RT_NULL, RT_NULL, RT_NULL, RT_NULL },
@@ -558,6 +856,14 @@ rtgui_blit_line_func rtgui_blit_line_get(int dst_bpp, int src_bpp)
     return _blit_table[dst_bpp][src_bpp];
 }
 
+rtgui_blit_line_func rtgui_blit_line_get_generic(int dst_bpp, int src_bpp)
+{
+    RT_ASSERT(dst_bpp > 0 && dst_bpp < 5);
+    RT_ASSERT(src_bpp > 0 && src_bpp < 5);
+
+    return _blit_table_generic[dst_bpp][src_bpp];
+}
+
 
 static void rtgui_blit_line_3_2_inv(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
 {
@@ -595,7 +901,7 @@ void rtgui_blit_line_2_2_inv(rt_uint8_t *dst_ptr, rt_uint8_t *src_ptr, int line)
     }
 }
 
-static const rtgui_blit_line_func _blit_table_inv[5][5] =
+static rtgui_blit_line_func _blit_table_inv[5][5] =
 {
     /* 0_0, 1_0, 2_0, 3_0, 4_0 */
     {RT_NULL, RT_NULL, RT_NULL, RT_NULL, RT_NULL },
@@ -618,6 +924,462 @@ rtgui_blit_line_func rtgui_blit_line_get_inv(int dst_bpp, int src_bpp)
     return _blit_table_inv[dst_bpp][src_bpp];
 }
 
+/* replace the generic converter in the blit tables */
+static void _blit_line_install(rtgui_blit_line_func generic, rtgui_blit_line_func func)
+{
+    int dst_bpp, src_bpp;
+
+    for (dst_bpp = 1; dst_bpp < 5; dst_bpp ++)
+    {
+        for (src_bpp = 1; src_bpp < 5; src_bpp ++)
+        {
+            if (_blit_table[dst_bpp][src_bpp] == generic)
+                _blit_table[dst_bpp][src_bpp] = func;
+            if (_blit_table_inv[dst_bpp][src_bpp] == generic)
+                _blit_table_inv[dst_bpp][src_bpp] = func;
+        }
+    }
+}
+
+void rtgui_blit_line_init(void)
+{
+#ifdef RTGUI_BLIT_SSE2
+    _blit_line_install(rtgui_blit_line_2_4, rtgui_blit_line_2_4_sse2);
+    _blit_line_install(rtgui_blit_line_4_2, rtgui_blit_line_4_2_sse2);
+#ifdef RTGUI_BLIT_SSSE3
+    if (__builtin_cpu_supports("ssse3"))
+    {
+        _blit_line_install(rtgui_blit_line_2_3, rtgui_blit_line_2_3_ssse3);
+        _blit_line_install(rtgui_blit_line_3_2, rtgui_blit_line_3_2_ssse3);
+        _blit_line_install(rtgui_blit_line_3_4, rtgui_blit_line_3_4_ssse3);
+        _blit_line_install(rtgui_blit_line_4_3, rtgui_blit_line_4_3_ssse3);
+    }
+#endif
+#ifdef RTGUI_BLIT_AVX2
+    if (__builtin_cpu_supports("avx2"))
+    {
+        _blit_line_install(rtgui_blit_line_2_4_sse2, rtgui_blit_line_2_4_avx2);
+        _blit_line_install(rtgui_blit_line_4_2_sse2, rtgui_blit_line_4_2_avx2);
+    }
+#endif
+#endif
+
+#ifdef RTGUI_BLIT_NEON
+    _blit_line_install(rtgui_blit_line_2_4, rtgui_blit_line_2_4_neon);
+    _blit_line_install(rtgui_blit_line_2_3, rtgui_blit_line_2_3_neon);
+    _blit_line_install(rtgui_blit_line_4_2, rtgui_blit_line_4_2_neon);
+    _blit_line_install(rtgui_blit_line_3_2, rtgui_blit_line_3_2_neon);
+    _blit_line_install(rtgui_blit_line_4_3, rtgui_blit_line_4_3_neon);
+    _blit_line_install(rtgui_blit_line_3_4, rtgui_blit_line_3_4_neon);
+#endif
+}
+
+/*
+ * Fill a line with one pixel value. The stores are 32 bits words, or 128 bits
+ * with SSE2/NEON, after the destination is aligned to a word.
+ */
+static void _blit_fill_words(rt_uint32_t *dst, rt_uint32_t word, int count)
+{
+#if defined(RTGUI_BLIT_SSE2)
+    __m128i v = _mm_set1_epi32((int)word);
+
+    for (; count >= 8; count -= 8)
+    {
+        _mm_storeu_si128((__m128i *)dst, v);
+        _mm_storeu_si128((__m128i *)(dst + 4), v);
+        dst += 8;
+    }
+#elif defined(RTGUI_BLIT_NEON)
+    uint32x4_t v = vdupq_n_u32(word);
+
+    for (; count >= 8; count -= 8)
+    {
+        vst1q_u32(dst, v);
+        vst1q_u32(dst + 4, v);
+        dst += 8;
+    }
+#else
+    for (; count >= 4; count -= 4)
+    {
+        dst[0] = word; dst[1] = word;
+        dst[2] = word; dst[3] = word;
+        dst += 4;
+    }
+#endif
+    while (count--)
+        *dst++ = word;
+}
+
+void rtgui_blit_fill_2(rt_uint8_t *dst, rt_uint32_t pixel, int count)
+{
+    if (count <= 0) return;
+    pixel &= 0xffff;
+    if ((pixel & 0xff) == (pixel >> 8))
+    {
+        rt_memset(dst, pixel & 0xff, count * 2);
+        return;
+    }
+
+    if ((rt_ubase_t)dst & 0x02)
+    {
+        *(rt_uint16_t *)dst = (rt_uint16_t)pixel;
+        dst += 2;
+        count --;
+    }
+    _blit_fill_words((rt_uint32_t *)dst, pixel | (pixel << 16), count >> 1);
+    if (count & 0x01)
+        *(rt_uint16_t *)(dst + (count & ~0x01) * 2) = (rt_uint16_t)pixel;
+}
+RTM_EXPORT(rtgui_blit_fill_2);
+
+void rtgui_blit_fill_3(rt_uint8_t *dst, rt_uint32_t pixel, int count)
+{
+    int size, done;
+
+    if (count <= 0) return;
+    size = count * 3;
+    if (((pixel & 0xff) == ((pixel >> 8) & 0xff)) &&
+        ((pixel & 0xff) == ((pixel >> 16) & 0xff)))
+    {
+        rt_memset(dst, pixel & 0xff, size);
+        return;
+    }
+
+    /* store one pixel, then double the filled bytes */
+    dst[0] = pixel & 0xff;
+    dst[1] = (pixel >> 8) & 0xff;
+    dst[2] = (pixel >> 16) & 0xff;
+    for (done = 3; done < size; done <<= 1)
+        rt_memcpy(dst + done, dst, _UI_MIN(done, size - done));
+}
+RTM_EXPORT(rtgui_blit_fill_3);
+
+void rtgui_blit_fill_4(rt_uint8_t *dst, rt_uint32_t pixel, int count)
+{
+    if (count <= 0) return;
+    if (pixel == (pixel & 0xff) * 0x01010101)
+    {
+        rt_memset(dst, pixel & 0xff, count * 4);
+        return;
+    }
+
+    _blit_fill_words((rt_uint32_t *)dst, pixel, count);
+}
+RTM_EXPORT(rtgui_blit_fill_4);
+
+/* exact x / 255 for x in [0, 255 * 255] */
+#define _DIV255(x)      (((x) + 1 + ((x) >> 8)) >> 8)
+
+#if defined(RTGUI_BLIT_SSE2) || defined(RTGUI_BLIT_NEON)
+#define RTGUI_BLIT_SIMD_ALPHA
+
+/*
+ * SIMD alpha blending. The components are blended as
+ * (s * a + d * (255 - a)) / 255 with the exact _DIV255, and for premultiplied
+ * ARGB8888 as s + d * (255 - a) / 255. The blocks of fully transparent or
+ * fully opaque source are skipped or copied. The row kernels return the
+ * count of blended pixels, the tail is blended in C.
+ */
+rt_inline rt_uint16_t _blend_565_pixel(rt_uint16_t d, unsigned sr, unsigned sg,
+                                              unsigned sb, unsigned a)
+{
+    unsigned ia = 255 - a;
+
+    return (rt_uint16_t)((_DIV255(sr * a + (d >> 11) * ia) << 11) |
+                         (_DIV255(sg * a + ((d >> 5) & 0x3F) * ia) << 5) |
+                          _DIV255(sb * a + (d & 0x1F) * ia));
+}
+
+rt_inline rt_uint32_t _blend_argb_pixel(rt_uint32_t d, rt_uint32_t s)
+{
+    unsigned ia = 255 - (s >> 24);
+
+    return ((s >> 24) + _DIV255((d >> 24) * ia)) << 24 |
+           (((s >> 16) & 0xFF) + _DIV255(((d >> 16) & 0xFF) * ia)) << 16 |
+           (((s >> 8) & 0xFF) + _DIV255(((d >> 8) & 0xFF) * ia)) << 8 |
+           ((s & 0xFF) + _DIV255((d & 0xFF) * ia));
+}
+
+#ifdef RTGUI_BLIT_SSE2
+#define _SSE2_DIV255(x)                                                         \
+    _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)),           \
+                                 _mm_srli_epi16(x, 8)), 8)
+
+/* blend component vectors of 16 bits with alpha a and 255 - a */
+#define _SSE2_BLEND(s, d, a, ia)                                                \
+    _SSE2_DIV255(_mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, ia)))
+
+static int _blend_565_row(rt_uint16_t *dst, const rt_uint16_t *src, int width, unsigned alpha)
+{
+    int n;
+    __m128i s, d, r, g, b;
+    const __m128i a = _mm_set1_epi16(alpha);
+    const __m128i ia = _mm_set1_epi16(255 - alpha);
+    const __m128i mask5 = _mm_set1_epi16(0x1F), mask6 = _mm_set1_epi16(0x3F);
+
+    for (n = 0; n + 8 <= width; n += 8)
+    {
+        s = _mm_loadu_si128((__m128i *)(src + n));
+        d = _mm_loadu_si128((__m128i *)(dst + n));
+
+        r = _SSE2_BLEND(_mm_srli_epi16(s, 11), _mm_srli_epi16(d, 11), a, ia);
+        g = _SSE2_BLEND(_mm_and_si128(_mm_srli_epi16(s, 5), mask6),
+                        _mm_and_si128(_mm_srli_epi16(d, 5), mask6), a, ia);
+        b = _SSE2_BLEND(_mm_and_si128(s, mask5), _mm_and_si128(d, mask5), a, ia);
+
+        d = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+        _mm_storeu_si128((__m128i *)(dst + n), d);
+    }
+
+    return n;
+}
+
+static int _blend_argb_565_row(rt_uint16_t *dst, const rt_uint32_t *src, int width)
+{
+    int n, amask;
+    __m128i s0, s1, d, a, ia, r, g, b;
+    const __m128i mask5 = _mm_set1_epi16(0x1F), mask6 = _mm_set1_epi16(0x3F);
+
+    for (n = 0; n + 8 <= width; n += 8)
+    {
+        s0 = _mm_loadu_si128((__m128i *)(src + n));
+        s1 = _mm_loadu_si128((__m128i *)(src + n + 4));
+
+        /* the alpha of 8 pixels in 16 bits */
+        a = _mm_packs_epi32(_mm_srli_epi32(s0, 24), _mm_srli_epi32(s1, 24));
+        amask = _mm_movemask_epi8(_mm_cmpeq_epi16(a, _mm_setzero_si128()));
+        if (amask == 0xFFFF)
+            continue;
+
+        amask = _mm_movemask_epi8(_mm_cmpeq_epi16(a, _mm_set1_epi16(0xFF)));
+        if (amask == 0xFFFF)
+        {
+            d = _SSE2_PACK_565(_SSE2_ARGB8888_TO_565(s0), _SSE2_ARGB8888_TO_565(s1));
+            _mm_storeu_si128((__m128i *)(dst + n), d);
+            continue;
+        }
+
+        ia = _mm_sub_epi16(_mm_set1_epi16(0xFF), a);
+        d = _mm_loadu_si128((__m128i *)(dst + n));
+
+        r = _mm_packs_epi32(_mm_srli_epi32(s0, 19), _mm_srli_epi32(s1, 19));
+        r = _SSE2_BLEND(_mm_and_si128(r, mask5), _mm_srli_epi16(d, 11), a, ia);
+        g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(s0, 10), _mm_set1_epi32(0x3F)),
+                            _mm_and_si128(_mm_srli_epi32(s1, 10), _mm_set1_epi32(0x3F)));
+        g = _SSE2_BLEND(g, _mm_and_si128(_mm_srli_epi16(d, 5), mask6), a, ia);
+        b = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(s0, 3), _mm_set1_epi32(0x1F)),
+                            _mm_and_si128(_mm_srli_epi32(s1, 3), _mm_set1_epi32(0x1F)));
+        b = _SSE2_BLEND(b, _mm_and_si128(d, mask5), a, ia);
+
+        d = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+        _mm_storeu_si128((__m128i *)(dst + n), d);
+    }
+
+    return n;
+}
+
+static int _blend_argb_argb_row(rt_uint32_t *dst, const rt_uint32_t *src, int width)
+{
+    int n;
+    __m128i s, d, s16, d16, ia, lo, hi;
+    const __m128i zero = _mm_setzero_si128();
+
+    for (n = 0; n + 4 <= width; n += 4)
+    {
+        s = _mm_loadu_si128((__m128i *)(src + n));
+
+        /* transparent pixels of premultiplied alpha are zero */
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(s, zero)) == 0xFFFF)
+            continue;
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(s, _mm_set1_epi32(0x00FFFFFF)),
+                                             _mm_set1_epi32(-1))) == 0xFFFF)
+        {
+            _mm_storeu_si128((__m128i *)(dst + n), s);
+            continue;
+        }
+
+        d = _mm_loadu_si128((__m128i *)(dst + n));
+
+        s16 = _mm_unpacklo_epi8(s, zero);
+        d16 = _mm_unpacklo_epi8(d, zero);
+        ia = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s16, 0xFF), 0xFF);
+        ia = _mm_sub_epi16(_mm_set1_epi16(0xFF), ia);
+        lo = _mm_add_epi16(s16, _SSE2_DIV255(_mm_mullo_epi16(d16, ia)));
+
+        s16 = _mm_unpackhi_epi8(s, zero);
+        d16 = _mm_unpackhi_epi8(d, zero);
+        ia = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s16, 0xFF), 0xFF);
+        ia = _mm_sub_epi16(_mm_set1_epi16(0xFF), ia);
+        hi = _mm_add_epi16(s16, _SSE2_DIV255(_mm_mullo_epi16(d16, ia)));
+
+        _mm_storeu_si128((__m128i *)(dst + n), _mm_packus_epi16(lo, hi));
+    }
+
+    return n;
+}
+#endif /* RTGUI_BLIT_SSE2 */
+
+#ifdef RTGUI_BLIT_NEON
+#define _NEON_DIV255(x)                                                         \
+    vshrq_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8)
+
+/* blend component vectors of 8 bits with alpha a and 255 - a */
+#define _NEON_BLEND(s, d, a, ia)                                                \
+    _NEON_DIV255(vmlal_u8(vmull_u8(s, a), d, ia))
+
+static int _blend_565_row(rt_uint16_t *dst, const rt_uint16_t *src, int width, unsigned alpha)
+{
+    int n;
+    uint16x8_t s, d, r, g, b;
+    const uint8x8_t a = vdup_n_u8(alpha);
+    const uint8x8_t ia = vdup_n_u8(255 - alpha);
+    const uint16x8_t mask5 = vdupq_n_u16(0x1F), mask6 = vdupq_n_u16(0x3F);
+
+    for (n = 0; n + 8 <= width; n += 8)
+    {
+        s = vld1q_u16(src + n);
+        d = vld1q_u16(dst + n);
+
+        r = _NEON_BLEND(vmovn_u16(vshrq_n_u16(s, 11)), vmovn_u16(vshrq_n_u16(d, 11)), a, ia);
+        g = _NEON_BLEND(vmovn_u16(vandq_u16(vshrq_n_u16(s, 5), mask6)),
+                        vmovn_u16(vandq_u16(vshrq_n_u16(d, 5), mask6)), a, ia);
+        b = _NEON_BLEND(vmovn_u16(vandq_u16(s, mask5)), vmovn_u16(vandq_u16(d, mask5)), a, ia);
+
+        vst1q_u16(dst + n, vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11), vshlq_n_u16(g, 5)), b));
+    }
+
+    return n;
+}
+
+static int _blend_argb_565_row(rt_uint16_t *dst, const rt_uint32_t *src, int width)
+{
+    int n;
+    uint8x8x4_t s;
+    uint8x8_t ia;
+    uint16x8_t d, r, g, b;
+    const uint16x8_t mask5 = vdupq_n_u16(0x1F), mask6 = vdupq_n_u16(0x3F);
+
+    for (n = 0; n + 8 <= width; n += 8)
+    {
+        s = vld4_u8((rt_uint8_t *)(src + n));
+
+        if (vget_lane_u64(vreinterpret_u64_u8(s.val[3]), 0) == 0)
+            continue;
+        if (vget_lane_u64(vreinterpret_u64_u8(s.val[3]), 0) == ~(uint64_t)0)
+        {
+            vst1q_u16(dst + n, _neon_rgb565_pack(s.val[2], s.val[1], s.val[0]));
+            continue;
+        }
+
+        ia = vmvn_u8(s.val[3]);
+        d = vld1q_u16(dst + n);
+
+        r = _NEON_BLEND(vshr_n_u8(s.val[2], 3), vmovn_u16(vshrq_n_u16(d, 11)), s.val[3], ia);
+        g = _NEON_BLEND(vshr_n_u8(s.val[1], 2), vmovn_u16(vandq_u16(vshrq_n_u16(d, 5), mask6)),
+                        s.val[3], ia);
+        b = _NEON_BLEND(vshr_n_u8(s.val[0], 3), vmovn_u16(vandq_u16(d, mask5)), s.val[3], ia);
+
+        vst1q_u16(dst + n, vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11), vshlq_n_u16(g, 5)), b));
+    }
+
+    return n;
+}
+
+static int _blend_argb_argb_row(rt_uint32_t *dst, const rt_uint32_t *src, int width)
+{
+    int n, index;
+    uint8x8x4_t s, d;
+    uint8x8_t ia;
+
+    for (n = 0; n + 8 <= width; n += 8)
+    {
+        s = vld4_u8((rt_uint8_t *)(src + n));
+
+        /* transparent pixels of premultiplied alpha are zero */
+        if (vget_lane_u64(vreinterpret_u64_u8(vorr_u8(vorr_u8(s.val[0], s.val[1]),
+                                                      vorr_u8(s.val[2], s.val[3]))), 0) == 0)
+            continue;
+        if (vget_lane_u64(vreinterpret_u64_u8(s.val[3]), 0) == ~(uint64_t)0)
+        {
+            vst4_u8((rt_uint8_t *)(dst + n), s);
+            continue;
+        }
+
+        d = vld4_u8((rt_uint8_t *)(dst + n));
+        ia = vmvn_u8(s.val[3]);
+        for (index = 0; index < 4; index ++)
+        {
+            uint16x8_t x = vmull_u8(d.val[index], ia);
+
+            d.val[index] = vqadd_u8(s.val[index], vmovn_u16(_NEON_DIV255(x)));
+        }
+        vst4_u8((rt_uint8_t *)(dst + n), d);
+    }
+
+    return n;
+}
+#endif /* RTGUI_BLIT_NEON */
+
+static void Blit565to565PixelAlphaSIMD(struct rtgui_blit_info *info)
+{
+    int n, width = info->dst_w, height = info->dst_h;
+    unsigned alpha = info->a;
+    rt_uint16_t *srcp = (rt_uint16_t *)info->src;
+    rt_uint16_t *dstp = (rt_uint16_t *)info->dst;
+
+    while (height--)
+    {
+        for (n = _blend_565_row(dstp, srcp, width, alpha); n < width; n ++)
+        {
+            rt_uint16_t s = srcp[n];
+
+            dstp[n] = _blend_565_pixel(dstp[n], s >> 11, (s >> 5) & 0x3F, s & 0x1F, alpha);
+        }
+        srcp = (rt_uint16_t *)((rt_uint8_t *)(srcp + width) + info->src_skip);
+        dstp = (rt_uint16_t *)((rt_uint8_t *)(dstp + width) + info->dst_skip);
+    }
+}
+
+static void BlitARGBto565PixelAlphaSIMD(struct rtgui_blit_info *info)
+{
+    int n, width = info->dst_w, height = info->dst_h;
+    rt_uint32_t *srcp = (rt_uint32_t *)info->src;
+    rt_uint16_t *dstp = (rt_uint16_t *)info->dst;
+
+    while (height--)
+    {
+        for (n = _blend_argb_565_row(dstp, srcp, width); n < width; n ++)
+        {
+            rt_uint32_t s = srcp[n];
+
+            dstp[n] = _blend_565_pixel(dstp[n], (s >> 19) & 0x1F, (s >> 10) & 0x3F,
+                                       (s >> 3) & 0x1F, s >> 24);
+        }
+        srcp = (rt_uint32_t *)((rt_uint8_t *)(srcp + width) + info->src_skip);
+        dstp = (rt_uint16_t *)((rt_uint8_t *)(dstp + width) + info->dst_skip);
+    }
+}
+
+static void BlitARGB8888toARGB8888PixelAlphaSIMD(struct rtgui_blit_info *info)
+{
+    int n, width = info->dst_w, height = info->dst_h;
+    rt_uint8_t *srcp = info->src;
+    rt_uint8_t *dstp = info->dst;
+
+    while (height--)
+    {
+        rt_uint32_t *src = (rt_uint32_t *)srcp;
+        rt_uint32_t *dst = (rt_uint32_t *)dstp;
+
+        for (n = _blend_argb_argb_row(dst, src, width); n < width; n ++)
+            dst[n] = _blend_argb_pixel(dst[n], src[n]);
+
+        srcp += info->src_pitch;
+        dstp += info->dst_pitch;
+    }
+}
+#endif /* RTGUI_BLIT_SSE2 || RTGUI_BLIT_NEON */
+
 /* 16bpp special case for per-surface alpha=50%: blend 2 pixels in parallel */
 /* blend a single 16 bit pixel at 50% */
 #define BLEND16_50(d, s, mask)						\
@@ -724,6 +1486,13 @@ static void
 Blit565to565PixelAlpha(struct rtgui_blit_info * info)
 {
     unsigned alpha = info->a;
+#ifdef RTGUI_BLIT_SIMD_ALPHA
+    if (alpha != 0 && alpha != 255)
+    {
+        Blit565to565PixelAlphaSIMD(info);
+        return;
+    }
+#endif
     if (alpha == 128)
     {
         Blit16to16SurfaceAlpha128(info, 0xf7de);
@@ -806,6 +1575,11 @@ static void BlitARGBto565PixelAlpha(struct rtgui_blit_info * info)
     rt_uint16_t *dstp = (rt_uint16_t *) info->dst;
     int dstskip = info->dst_skip >> 1;
 
+#ifdef RTGUI_BLIT_SIMD_ALPHA
+    BlitARGBto565PixelAlphaSIMD(info);
+    return;
+#endif
+
     while (height--) {
 	    /* *INDENT-OFF* */
 	    DUFFS_LOOP4({
@@ -848,6 +1622,11 @@ static void BlitARGB8888toARGB8888PixelAlpha(struct rtgui_blit_info *info)
     rt_uint32_t dstpixel;
     rt_uint32_t dstR, dstG, dstB, dstA;
 
+#ifdef RTGUI_BLIT_SIMD_ALPHA
+    BlitARGB8888toARGB8888PixelAlphaSIMD(info);
+    return;
+#endif
+
     while (info->dst_h--) {
         rt_uint32_t *src = (rt_uint32_t *)info->src;
         rt_uint32_t *dst = (rt_uint32_t *)info->dst;
@@ -858,10 +1637,10 @@ static void BlitARGB8888toARGB8888PixelAlpha(struct rtgui_blit_info *info)
             dstpixel = *dst;
             dstA = (rt_uint8_t)(dstpixel >> 24); dstR = (rt_uint8_t)(dstpixel >> 16); dstG = (rt_uint8_t)(dstpixel >> 8); dstB = (rt_uint8_t)dstpixel;
 
-            dstR = srcR + ((255 - srcA) * dstR) / 255;
-            dstG = srcG + ((255 - srcA) * dstG) / 255;
-            dstB = srcB + ((255 - srcA) * dstB) / 255;
-            dstA = srcA + ((255 - srcA) * dstA) / 255;
+            dstR = srcR + _DIV255((255 - srcA) * dstR);
+            dstG = srcG + _DIV255((255 - srcA) * dstG);
+            dstB = srcB + _DIV255((255 - srcA) * dstB);
+            dstA = srcA + _DIV255((255 - srcA) * dstA);
 
             dstpixel = ((rt_uint32_t)dstA << 24) | ((rt_uint32_t)dstR << 16) | ((rt_uint32_t)dstG << 8) | dstB;
             *dst = dstpixel;
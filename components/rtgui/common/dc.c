@@ -21,20 +21,17 @@
 #include <rtgui/dc.h>
 #include <rtgui/dc_hw.h>
 #include <rtgui/dc_client.h>
+#include <rtgui/dc_record.h>
 
 #include <rtgui/rtgui_system.h>
 #include <rtgui/rtgui_server.h>
+#include <rtgui/rtgui_app.h>
 #include <rtgui/widgets/window.h>
 #include <rtgui/widgets/title.h>
 
 #include <string.h> /* for strlen */
 #include <stdlib.h> /* fir qsort  */
 
-static int _int_compare(const void *a, const void *b)
-{
-    return (*(const int *) a) - (*(const int *) b);
-}
-
 void rtgui_dc_destory(struct rtgui_dc *dc)
 {
     if (dc == RT_NULL) return;
@@ -356,20 +353,46 @@ RTM_EXPORT(rtgui_dc_draw_text_stroke);
  */
 void rtgui_dc_draw_mono_bmp(struct rtgui_dc *dc, int x, int y, int w, int h, const rt_uint8_t *data)
 {
-    int i, j, k;
-
     /* get word bytes */
     w = (w + 7) / 8;
 
     /* draw mono bitmap data */
-    for (i = 0; i < h; i ++)
-        for (j = 0; j < w; j++)
-            for (k = 0; k < 8; k++)
-                if (((data[i * w + j] >> (7 - k)) & 0x01) != 0)
-                    rtgui_dc_draw_point(dc, x + 8 * j + k, y + i);
+    rtgui_dc_blit_mono(dc, x, y, w * 8, h, data, w, RT_FALSE);
 }
 RTM_EXPORT(rtgui_dc_draw_mono_bmp);
 
+/*
+ * draw 1bpp mask in the runs of hline, used by the dc engine without
+ * blit_mono
+ */
+void rtgui_dc_blit_mono_runs(struct rtgui_dc *dc, int x, int y, int w, int h,
+                             const rt_uint8_t *mask, int pitch, rt_bool_t background)
+{
+    int i, j, end;
+    rtgui_rect_t rect;
+
+    for (i = 0; i < h; i ++, mask += pitch)
+    {
+        for (j = 0; j < w; j = end)
+        {
+            end = rtgui_dc_mono_run(mask, j, w);
+            if (mask[j >> 3] & (0x80 >> (j & 0x07)))
+            {
+                rtgui_dc_draw_hline(dc, x + j, x + end, y + i);
+            }
+            else if (background)
+            {
+                rect.x1 = x + j;
+                rect.x2 = x + end;
+                rect.y1 = y + i;
+                rect.y2 = y + i + 1;
+                rtgui_dc_fill_rect(dc, &rect);
+            }
+        }
+    }
+}
+RTM_EXPORT(rtgui_dc_blit_mono_runs);
+
 void rtgui_dc_draw_byte(struct rtgui_dc *dc, int x, int y, int h, const rt_uint8_t *data)
 {
     rtgui_dc_draw_mono_bmp(dc, x, y, 8, h, data);
@@ -469,16 +492,28 @@ void rtgui_dc_draw_polygon(struct rtgui_dc *dc, const int *vx, const int *vy, in
 }
 RTM_EXPORT(rtgui_dc_draw_polygon);
 
+/* the edge of polygon in the edge table */
+struct _poly_edge
+{
+    /* scanlines in [y1, y2) */
+    int y1, y2;
+    /* x on current scanline and the step for each scanline, in 16.16 */
+    int x, dx;
+};
+
+static int _poly_edge_compare(const void *a, const void *b)
+{
+    return ((const struct _poly_edge *) a)->y1 - ((const struct _poly_edge *) b)->y1;
+}
+
 void rtgui_dc_fill_polygon(struct rtgui_dc *dc, const int *vx, const int *vy, int count)
 {
-    int i;
+    int i, j;
     int y, xa, xb;
     int miny, maxy;
-    int x1, y1;
-    int x2, y2;
-    int ind1, ind2;
-    int ints;
-    int *poly_ints = RT_NULL;
+    int edges, next, actives;
+    struct _poly_edge *edge_table, *edge;
+    struct _poly_edge **active;
 
     /*
      * Sanity check number of edges
@@ -486,79 +521,95 @@ void rtgui_dc_fill_polygon(struct rtgui_dc *dc, const int *vx, const int *vy, in
     if (count < 3) return;
 
     /*
-     * Allocate temp array, only grow array
+     * Allocate the edge table and the active edge list
      */
-    poly_ints = (int *) rtgui_malloc(sizeof(int) * count);
-    if (poly_ints == RT_NULL) return ; /* no memory, failed */
+    edge_table = (struct _poly_edge *) rtgui_malloc((sizeof(struct _poly_edge) +
+                 sizeof(struct _poly_edge *)) * count);
+    if (edge_table == RT_NULL) return ; /* no memory, failed */
+    active = (struct _poly_edge **)(edge_table + count);
 
     /*
-     * Determine Y maximal
+     * Build the edge table, horizontal edges are dropped
      */
-    miny = vy[0];
-    maxy = vy[0];
-    for (i = 1; (i < count); i++)
+    edges = 0;
+    miny = maxy = vy[0];
+    for (i = 0; i < count; i++)
     {
-        if (vy[i] < miny) miny = vy[i];
-        else if (vy[i] > maxy) maxy = vy[i];
+        int x1, y1, x2, y2;
+
+        j = (i == 0) ? count - 1 : i - 1;
+        if (vy[j] < vy[i])
+        {
+            x1 = vx[j]; y1 = vy[j];
+            x2 = vx[i]; y2 = vy[i];
+        }
+        else if (vy[j] > vy[i])
+        {
+            x1 = vx[i]; y1 = vy[i];
+            x2 = vx[j]; y2 = vy[j];
+        }
+        else
+        {
+            continue;
+        }
+
+        if (y1 < miny) miny = y1;
+        if (y2 > maxy) maxy = y2;
+
+        edge = &edge_table[edges++];
+        edge->y1 = y1;
+        edge->y2 = y2;
+        edge->x  = x1 << 16;
+        edge->dx = ((x2 - x1) << 16) / (y2 - y1);
     }
 
+    /* sort the edge table on the top scanline of edge */
+    qsort(edge_table, edges, sizeof(struct _poly_edge), _poly_edge_compare);
+
     /*
      * Draw, scanning y
      */
+    next = 0;
+    actives = 0;
     for (y = miny; (y <= maxy); y++)
     {
-        ints = 0;
-        for (i = 0; (i < count); i++)
+        /* the edges are in [y1, y2), except the bottom scanline of polygon */
+        for (i = 0, j = 0; i < actives; i++)
         {
-            if (!i)
-            {
-                ind1 = count - 1;
-                ind2 = 0;
-            }
-            else
-            {
-                ind1 = i - 1;
-                ind2 = i;
-            }
-            y1 = vy[ind1];
-            y2 = vy[ind2];
-            if (y1 < y2)
-            {
-                x1 = vx[ind1];
-                x2 = vx[ind2];
-            }
-            else if (y1 > y2)
-            {
-                y2 = vy[ind1];
-                y1 = vy[ind2];
-                x2 = vx[ind1];
-                x1 = vx[ind2];
-            }
-            else
-            {
-                continue;
-            }
-
-            if (((y >= y1) && (y < y2)) || ((y == maxy) && (y > y1) && (y <= y2)))
-            {
-                poly_ints[ints++] = ((65536 * (y - y1)) / (y2 - y1)) * (x2 - x1) + (65536 * x1);
-            }
+            if (active[i]->y2 > y || y == maxy)
+                active[j++] = active[i];
         }
+        actives = j;
 
-        qsort(poly_ints, ints, sizeof(int), _int_compare);
+        /* add the edges start on this scanline */
+        while (next < edges && edge_table[next].y1 == y)
+            active[actives++] = &edge_table[next++];
 
-        for (i = 0; (i < ints); i += 2)
+        /* the list keeps sorted by x mostly, so insertion sort it */
+        for (i = 1; i < actives; i++)
         {
-            xa = poly_ints[i] + 1;
+            edge = active[i];
+            for (j = i; j > 0 && active[j - 1]->x > edge->x; j--)
+                active[j] = active[j - 1];
+            active[j] = edge;
+        }
+
+        for (i = 0; (i + 1 < actives); i += 2)
+        {
+            xa = active[i]->x + 1;
             xa = (xa >> 16) + ((xa & 32768) >> 15);
-            xb = poly_ints[i + 1] - 1;
+            xb = active[i + 1]->x - 1;
             xb = (xb >> 16) + ((xb & 32768) >> 15);
             rtgui_dc_draw_hline(dc, xa, xb, y);
         }
+
+        /* step to next scanline */
+        for (i = 0; i < actives; i++)
+            active[i]->x += active[i]->dx;
     }
 
     /* release memory */
-    rtgui_free(poly_ints);
+    rtgui_free(edge_table);
 }
 RTM_EXPORT(rtgui_dc_fill_polygon);
 
@@ -1561,6 +1612,14 @@ void rtgui_dc_set_gc(struct rtgui_dc *dc, rtgui_gc_t *gc)
             dc_buffer->gc = *gc;
             break;
         }
+    case RTGUI_DC_RECORD:
+        {
+            struct rtgui_dc_record *dc_record;
+
+            dc_record = (struct rtgui_dc_record*)dc;
+            dc_record->gc = *gc;
+            break;
+        }
     }
 }
 RTM_EXPORT(rtgui_dc_set_gc);
@@ -1601,6 +1660,14 @@ rtgui_gc_t *rtgui_dc_get_gc(struct rtgui_dc *dc)
             gc = &dc_buffer->gc;
             break;
         }
+    case RTGUI_DC_RECORD:
+        {
+            struct rtgui_dc_record *dc_record;
+
+            dc_record = (struct rtgui_dc_record*)dc;
+            gc = &dc_record->gc;
+            break;
+        }
     }
 
     return gc;
@@ -1682,6 +1749,14 @@ void rtgui_dc_get_rect(struct rtgui_dc *dc, rtgui_rect_t *rect)
             rtgui_rect_init(rect, 0, 0, dc_buffer->width, dc_buffer->height);
             break;
         }
+    case RTGUI_DC_RECORD:
+        {
+            struct rtgui_dc_record *dc_record;
+
+            dc_record = (struct rtgui_dc_record*)dc;
+            rtgui_rect_init(rect, 0, 0, dc_record->width, dc_record->height);
+            break;
+        }
     }
 
     return;
@@ -1713,6 +1788,14 @@ rt_uint8_t rtgui_dc_get_pixel_format(struct rtgui_dc *dc)
             pixel_fmt = dc_buffer->pixel_format;
             break;
         }
+    case RTGUI_DC_RECORD:
+        {
+            struct rtgui_dc_record *dc_record;
+
+            dc_record = (struct rtgui_dc_record*)dc;
+            pixel_fmt = dc_record->pixel_format;
+            break;
+        }
     default:
         RT_ASSERT(0);
     }
@@ -1747,6 +1830,7 @@ void rtgui_dc_logic_to_device(struct rtgui_dc* dc, struct rtgui_point *point)
         }
 
     case RTGUI_DC_BUFFER: /* no conversion */
+    case RTGUI_DC_RECORD:
         break;
     }
 }
@@ -1777,6 +1861,7 @@ void rtgui_dc_rect_to_device(struct rtgui_dc* dc, struct rtgui_rect* rect)
         }
 
     case RTGUI_DC_BUFFER: /* no conversion */
+    case RTGUI_DC_RECORD:
         break;
     }
 }
@@ -1786,6 +1871,14 @@ extern struct rt_mutex cursor_mutex;
 extern void rtgui_mouse_show_cursor(void);
 extern void rtgui_mouse_hide_cursor(void);
 
+#ifdef RTGUI_USING_COMPOSITOR
+/* windows draw to their own surfaces and server composes the screen, only the
+ * drawing in virtual mode goes to a shared framebuffer */
+#define _dc_on_screen()     (rtgui_graphic_driver_is_vmode() == RT_TRUE)
+#else
+#define _dc_on_screen()     RT_TRUE
+#endif
+
 struct rtgui_dc *rtgui_dc_begin_drawing(rtgui_widget_t *owner)
 {
     struct rtgui_dc *dc;
@@ -1826,7 +1919,26 @@ struct rtgui_dc *rtgui_dc_begin_drawing(rtgui_widget_t *owner)
         }
     }
 
-    rtgui_screen_lock(RT_WAITING_FOREVER);
+#ifdef RTGUI_USING_COMPOSITOR
+    if (!_dc_on_screen())
+    {
+        if (win->surface == RT_NULL)
+        {
+            /* server has no surface for the window */
+            win->drawing --;
+            return RT_NULL;
+        }
+        /* the driver of application is the surface now */
+        rtgui_app_self()->surface = win->surface;
+    }
+#endif
+    if (_dc_on_screen())
+        rtgui_screen_lock(RT_WAITING_FOREVER);
+
+#ifdef RTGUI_USING_LAZY_CLIP
+    /* the clip of owner may be out of date */
+    rtgui_widget_validate_clip(owner);
+#endif
 
     /* create client or hardware DC */
     if ((rtgui_region_is_flat(&owner->clip) == RT_EOK) &&
@@ -1839,8 +1951,14 @@ struct rtgui_dc *rtgui_dc_begin_drawing(rtgui_widget_t *owner)
     {
         /* restore drawing counter */
         win->drawing--;
-        rtgui_screen_unlock();
+        if (_dc_on_screen())
+            rtgui_screen_unlock();
+#ifdef RTGUI_USING_COMPOSITOR
+        else if (win->drawing == 0)
+            rtgui_app_self()->surface = RT_NULL;
+#endif
     }
+#ifndef RTGUI_USING_COMPOSITOR
     else if (win->drawing == 1 && rtgui_graphic_driver_is_vmode() == RT_FALSE)
     {
 #ifdef RTGUI_USING_MOUSE_CURSOR
@@ -1858,6 +1976,7 @@ struct rtgui_dc *rtgui_dc_begin_drawing(rtgui_widget_t *owner)
             rtgui_server_post_event((struct rtgui_event *)&eupdate, sizeof(eupdate));
         }
     }
+#endif
 
     return dc;
 }
@@ -1879,10 +1998,17 @@ void rtgui_dc_end_drawing(struct rtgui_dc *dc)
     /* get window */
     win = owner->toplevel;
 
+    /* write out the batched drawing before the cursor and update */
+    rtgui_graphic_driver_flush(rtgui_graphic_driver_get_default());
+
     /* decrease drawing counter */
     win->drawing --;
     if (win->drawing == 0 && rtgui_graphic_driver_is_vmode() == RT_FALSE)
     {
+#ifdef RTGUI_USING_COMPOSITOR
+        /* back to the screen driver */
+        rtgui_app_self()->surface = RT_NULL;
+#else
 #ifdef RTGUI_USING_MOUSE_CURSOR
         rt_mutex_release(&cursor_mutex);
         /* show cursor */
@@ -1896,18 +2022,21 @@ void rtgui_dc_end_drawing(struct rtgui_dc *dc)
                                                &(owner->extent));
         }
         else
+#endif
         {
             /* send to server for window update */
             struct rtgui_event_update_end eupdate;
             RTGUI_EVENT_UPDATE_END_INIT(&(eupdate));
             eupdate.rect = owner->extent;
+            eupdate.wid = win;
 
             rtgui_server_post_event((struct rtgui_event *)&eupdate, sizeof(eupdate));
         }
     }
 
     dc->engine->fini(dc);
-    rtgui_screen_unlock();
+    if (_dc_on_screen())
+        rtgui_screen_unlock();
 }
 RTM_EXPORT(rtgui_dc_end_drawing);
 
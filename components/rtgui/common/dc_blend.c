@@ -467,7 +467,7 @@ static void _do_draw_line(struct rtgui_dc * dst,
 		        int draw_x1, draw_x2;
 		        int draw_y1, draw_y2;
 
-		        prect = ((rtgui_rect_t *)(owner->clip.data + index + 1));
+		        prect = ((rtgui_rect_t *)(owner->clip.data + 1)) + index;
 		        draw_x1 = x1; draw_x2 = x2;
 		        draw_y1 = y1; draw_y2 = y2;
 
@@ -1264,7 +1264,7 @@ static void _do_blend_line(struct rtgui_dc * dst,
                 int draw_x1, draw_x2;
                 int draw_y1, draw_y2;
 
-                prect = ((rtgui_rect_t *)(owner->clip.data + index + 1));
+                prect = ((rtgui_rect_t *)(owner->clip.data + 1)) + index;
                 draw_x1 = x1; draw_x2 = x2;
                 draw_y1 = y1; draw_y2 = y2;
 
@@ -1527,7 +1527,7 @@ rtgui_dc_blend_fill_rect(struct rtgui_dc* dst, const rtgui_rect_t *rect,
 	        {
 	            rtgui_rect_t *prect;
 
-	            prect = ((rtgui_rect_t *)(owner->clip.data + index + 1));
+	            prect = ((rtgui_rect_t *)(owner->clip.data + 1)) + index;
 
 				draw_rect = *rect;
 				rtgui_rect_moveto(&draw_rect,owner->extent.x1, owner->extent.y1);
@@ -1637,7 +1637,7 @@ rtgui_dc_blend_fill_rects(struct rtgui_dc * dst, const rtgui_rect_t *rects, int
 		        {
 		            rtgui_rect_t *prect;
 
-		            prect = ((rtgui_rect_t *)(owner->clip.data + index + 1));
+		            prect = ((rtgui_rect_t *)(owner->clip.data + 1)) + index;
 
 					draw_rect = rect;
 					rtgui_rect_moveto(&draw_rect,owner->extent.x1, owner->extent.y1);
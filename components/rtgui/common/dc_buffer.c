@@ -22,34 +22,179 @@
 #include <string.h>
 
 static rt_bool_t rtgui_dc_buffer_fini(struct rtgui_dc *dc);
-static void rtgui_dc_buffer_draw_point(struct rtgui_dc *dc, int x, int y);
-static void rtgui_dc_buffer_draw_color_point(struct rtgui_dc *dc, int x, int y, rtgui_color_t color);
-static void rtgui_dc_buffer_draw_vline(struct rtgui_dc *dc, int x, int y1, int y2);
-static void rtgui_dc_buffer_draw_hline(struct rtgui_dc *dc, int x1, int x2, int y);
-static void rtgui_dc_buffer_fill_rect(struct rtgui_dc *dc, struct rtgui_rect *rect);
 static void rtgui_dc_buffer_blit_line(struct rtgui_dc *self, int x1, int x2, int y, rt_uint8_t *line_data);
 static void rtgui_dc_buffer_blit(struct rtgui_dc *self, struct rtgui_point *dc_point,
                                  struct rtgui_dc *dest, rtgui_rect_t *rect);
 
+#define _dc_get_pitch(dc) 			\
+	(dc->pitch)
+#define _dc_get_pixel(dc, x, y)		\
+	((dc)->pixel + (y) * (dc)->pitch + (x) * rtgui_color_get_bpp((dc)->pixel_format))
+#define _dc_get_bits_per_pixel(dc)	\
+	rtgui_color_get_bits(dc->pixel_format)
+
+/* store one pixel of 2, 3 or 4 bytes */
+#define _dc_buffer_set_2(ptr, pixel)    (*(rt_uint16_t *)(ptr) = (rt_uint16_t)(pixel))
+#define _dc_buffer_set_3(ptr, pixel)    \
+    do { (ptr)[0] = (pixel) & 0xff; (ptr)[1] = ((pixel) >> 8) & 0xff; (ptr)[2] = ((pixel) >> 16) & 0xff; } while (0)
+#define _dc_buffer_set_4(ptr, pixel)    (*(rt_uint32_t *)(ptr) = (rt_uint32_t)(pixel))
+
+/* rtgui color to pixel of each format, RGB888 is stored as B, G, R bytes */
+#define _dc_buffer_to_rgb565(c)         rtgui_color_to_565(c)
+#define _dc_buffer_to_bgr565(c)         rtgui_color_to_565p(c)
+#define _dc_buffer_to_rgb888(c)         rtgui_color_to_888(c)
+#define _dc_buffer_to_argb888(c)        ((rt_uint32_t)(c))
+
+/*
+ * The drawing primitives of one pixel format. The color is converted to a
+ * pixel once for each call, and the pixels are stored without checking the
+ * pixel format again.
+ */
+#define DC_BUFFER_ENGINE(fmt, bpp)                                              \
+static void _dc_buffer_draw_point_##fmt(struct rtgui_dc *self, int x, int y)   \
+{                                                                               \
+    struct rtgui_dc_buffer *dst = (struct rtgui_dc_buffer *)self;               \
+    rt_uint8_t *ptr;                                                            \
+                                                                                \
+    if ((x < 0) || (y < 0) || (x >= dst->width) || (y >= dst->height)) return; \
+    ptr = dst->pixel + y * dst->pitch + x * bpp;                                \
+    _dc_buffer_set_##bpp(ptr, _dc_buffer_to_##fmt(dst->gc.foreground));        \
+}                                                                               \
+                                                                                \
+static void _dc_buffer_draw_color_point_##fmt(struct rtgui_dc *self,           \
+                                              int x, int y, rtgui_color_t color)\
+{                                                                               \
+    struct rtgui_dc_buffer *dst = (struct rtgui_dc_buffer *)self;               \
+    rt_uint8_t *ptr;                                                            \
+                                                                                \
+    if ((x < 0) || (y < 0) || (x >= dst->width) || (y >= dst->height)) return; \
+    ptr = dst->pixel + y * dst->pitch + x * bpp;                                \
+    _dc_buffer_set_##bpp(ptr, _dc_buffer_to_##fmt(color));                     \
+}                                                                               \
+                                                                                \
+static void _dc_buffer_draw_vline_##fmt(struct rtgui_dc *self,                 \
+                                        int x, int y1, int y2)                  \
+{                                                                               \
+    struct rtgui_dc_buffer *dst = (struct rtgui_dc_buffer *)self;               \
+    rt_uint32_t pixel;                                                          \
+    rt_uint8_t *ptr;                                                            \
+                                                                                \
+    if ((x < 0) || (x >= dst->width)) return;                                   \
+    if (y1 > y2) { int t = y1; y1 = y2 + 1; y2 = t + 1; }                       \
+    if (y1 < 0) y1 = 0;                                                         \
+    if (y2 > dst->height) y2 = dst->height;                                     \
+                                                                                \
+    pixel = _dc_buffer_to_##fmt(dst->gc.foreground);                            \
+    ptr = dst->pixel + y1 * dst->pitch + x * bpp;                               \
+    for (; y1 < y2; y1 ++)                                                      \
+    {                                                                           \
+        _dc_buffer_set_##bpp(ptr, pixel);                                       \
+        ptr += dst->pitch;                                                      \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static void _dc_buffer_draw_hline_##fmt(struct rtgui_dc *self,                 \
+                                        int x1, int x2, int y)                  \
+{                                                                               \
+    struct rtgui_dc_buffer *dst = (struct rtgui_dc_buffer *)self;               \
+                                                                                \
+    if ((y < 0) || (y >= dst->height)) return;                                  \
+    if (x1 > x2) { int t = x1; x1 = x2 + 1; x2 = t + 1; }                       \
+    if (x1 < 0) x1 = 0;                                                         \
+    if (x2 > dst->width) x2 = dst->width;                                       \
+                                                                                \
+    rtgui_blit_fill_##bpp(dst->pixel + y * dst->pitch + x1 * bpp,               \
+                          _dc_buffer_to_##fmt(dst->gc.foreground), x2 - x1);    \
+}                                                                               \
+                                                                                \
+static void _dc_buffer_fill_rect_##fmt(struct rtgui_dc *self,                  \
+                                       struct rtgui_rect *dst_rect)             \
+{                                                                               \
+    struct rtgui_dc_buffer *dst = (struct rtgui_dc_buffer *)self;               \
+    rtgui_rect_t rect;                                                          \
+    rt_uint32_t pixel;                                                          \
+    rt_uint8_t *ptr;                                                            \
+    int width;                                                                  \
+                                                                                \
+    if (dst_rect == RT_NULL) rtgui_dc_get_rect(self, &rect);                    \
+    else rect = *dst_rect;                                                      \
+    if (rect.x1 < 0) rect.x1 = 0;                                               \
+    if (rect.y1 < 0) rect.y1 = 0;                                               \
+    if (rect.x2 > dst->width) rect.x2 = dst->width;                             \
+    if (rect.y2 > dst->height) rect.y2 = dst->height;                           \
+    if ((rect.x1 >= rect.x2) || (rect.y1 >= rect.y2)) return;                   \
+                                                                                \
+    pixel = _dc_buffer_to_##fmt(dst->gc.background);                            \
+    ptr = dst->pixel + rect.y1 * dst->pitch + rect.x1 * bpp;                    \
+    width = rect.x2 - rect.x1;                                                  \
+    /* whole rows are contiguous: fill them in one go */                        \
+    if (width * bpp == dst->pitch)                                              \
+    {                                                                           \
+        rtgui_blit_fill_##bpp(ptr, pixel, width * (rect.y2 - rect.y1));         \
+        return;                                                                 \
+    }                                                                           \
+    for (; rect.y1 < rect.y2; rect.y1 ++)                                       \
+    {                                                                           \
+        rtgui_blit_fill_##bpp(ptr, pixel, width);                               \
+        ptr += dst->pitch;                                                      \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+const static struct rtgui_dc_engine dc_buffer_engine_##fmt =                   \
+{                                                                               \
+    _dc_buffer_draw_point_##fmt,                                                \
+    _dc_buffer_draw_color_point_##fmt,                                          \
+    _dc_buffer_draw_vline_##fmt,                                                \
+    _dc_buffer_draw_hline_##fmt,                                                \
+    _dc_buffer_fill_rect_##fmt,                                                 \
+    rtgui_dc_buffer_blit_line,                                                  \
+    rtgui_dc_buffer_blit,                                                       \
+    RT_NULL,                                                                    \
+                                                                                \
+    rtgui_dc_buffer_fini,                                                       \
+};
+
+DC_BUFFER_ENGINE(rgb565, 2)
+DC_BUFFER_ENGINE(bgr565, 2)
+DC_BUFFER_ENGINE(rgb888, 3)
+DC_BUFFER_ENGINE(argb888, 4)
+
+/* the other pixel formats have no drawing primitives, only blit */
+static void _dc_buffer_draw_point_none(struct rtgui_dc *self, int x, int y) {}
+static void _dc_buffer_draw_color_point_none(struct rtgui_dc *self, int x, int y, rtgui_color_t color) {}
+static void _dc_buffer_draw_line_none(struct rtgui_dc *self, int a1, int a2, int b) {}
+static void _dc_buffer_fill_rect_none(struct rtgui_dc *self, struct rtgui_rect *rect) {}
+
 const static struct rtgui_dc_engine dc_buffer_engine =
 {
-    rtgui_dc_buffer_draw_point,
-    rtgui_dc_buffer_draw_color_point,
-    rtgui_dc_buffer_draw_vline,
-    rtgui_dc_buffer_draw_hline,
-    rtgui_dc_buffer_fill_rect,
+    _dc_buffer_draw_point_none,
+    _dc_buffer_draw_color_point_none,
+    _dc_buffer_draw_line_none,
+    _dc_buffer_draw_line_none,
+    _dc_buffer_fill_rect_none,
     rtgui_dc_buffer_blit_line,
     rtgui_dc_buffer_blit,
+    RT_NULL,
 
     rtgui_dc_buffer_fini,
 };
 
-#define _dc_get_pitch(dc) 			\
-	(dc->pitch)
-#define _dc_get_pixel(dc, x, y)		\
-	((dc)->pixel + (y) * (dc)->pitch + (x) * rtgui_color_get_bpp((dc)->pixel_format))
-#define _dc_get_bits_per_pixel(dc)	\
-	rtgui_color_get_bits(dc->pixel_format)
+static const struct rtgui_dc_engine *_dc_buffer_engine_get(rt_uint8_t pixel_format)
+{
+    switch (pixel_format)
+    {
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565:
+        return &dc_buffer_engine_rgb565;
+    case RTGRAPHIC_PIXEL_FORMAT_BGR565:
+        return &dc_buffer_engine_bgr565;
+    case RTGRAPHIC_PIXEL_FORMAT_RGB888:
+        return &dc_buffer_engine_rgb888;
+    case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
+        return &dc_buffer_engine_argb888;
+    }
+
+    return &dc_buffer_engine;
+}
 
 struct rtgui_dc *rtgui_dc_buffer_create(int w, int h)
 {
@@ -68,7 +213,7 @@ struct rtgui_dc *rtgui_dc_buffer_create_pixformat(rt_uint8_t pixel_format, int w
 
     dc = (struct rtgui_dc_buffer *)rtgui_malloc(sizeof(struct rtgui_dc_buffer));
     dc->parent.type   = RTGUI_DC_BUFFER;
-    dc->parent.engine = &dc_buffer_engine;
+    dc->parent.engine = _dc_buffer_engine_get(pixel_format);
     dc->gc.foreground = default_foreground;
     dc->gc.background = default_background;
     dc->gc.font = rtgui_font_default();
@@ -138,186 +283,6 @@ static rt_bool_t rtgui_dc_buffer_fini(struct rtgui_dc *dc)
     return RT_TRUE;
 }
 
-static void rtgui_dc_buffer_draw_point(struct rtgui_dc *self, int x, int y)
-{
-    struct rtgui_dc_buffer *dst;
-    unsigned r, g, b, a;
-
-    dst = (struct rtgui_dc_buffer *)self;
-
-    /* does not draw point out of dc */
-    if ((x > dst->width) || (y > dst->height)) return ;
-
-	r = RTGUI_RGB_R(dst->gc.foreground);
-	g = RTGUI_RGB_G(dst->gc.foreground);
-	b = RTGUI_RGB_B(dst->gc.foreground);
-	a = RTGUI_RGB_A(dst->gc.foreground);
-
-	switch (dst->pixel_format)
-	{
-	case RTGRAPHIC_PIXEL_FORMAT_RGB565:
-		DRAW_SETPIXELXY_RGB565(x, y);
-		break;
-	case RTGRAPHIC_PIXEL_FORMAT_BGR565:
-		DRAW_SETPIXELXY_BGR565(x, y);
-		break;
-	case RTGRAPHIC_PIXEL_FORMAT_RGB888:
-		DRAW_SETPIXELXY_RGB888(x, y);
-		break;
-	case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
-		DRAW_SETPIXELXY_ARGB8888(x, y);
-		break;
-	}
-}
-
-static void rtgui_dc_buffer_draw_color_point(struct rtgui_dc *self, int x, int y, rtgui_color_t color)
-{
-	struct rtgui_dc_buffer *dst;
-	unsigned r, g, b, a;
-
-	dst = (struct rtgui_dc_buffer *)self;
-
-	/* does not draw point out of dc */
-	if ((x > dst->width) || (y > dst->height)) return ;
-
-	r = RTGUI_RGB_R(color);
-	g = RTGUI_RGB_G(color);
-	b = RTGUI_RGB_B(color);
-	a = RTGUI_RGB_A(color);
-
-	switch (dst->pixel_format)
-	{
-	case RTGRAPHIC_PIXEL_FORMAT_RGB565:
-		DRAW_SETPIXELXY_RGB565(x, y);
-		break;
-	case RTGRAPHIC_PIXEL_FORMAT_BGR565:
-		DRAW_SETPIXELXY_BGR565(x, y);
-		break;
-	case RTGRAPHIC_PIXEL_FORMAT_RGB888:
-		DRAW_SETPIXELXY_RGB888(x, y);
-		break;
-	case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
-		DRAW_SETPIXELXY_ARGB8888(x, y);
-		break;
-	}
-}
-
-static void rtgui_dc_buffer_draw_vline(struct rtgui_dc *self, int x1, int y1, int y2)
-{
-    struct rtgui_dc_buffer *dst;
-    unsigned r, g, b, a;
-
-    dst = (struct rtgui_dc_buffer *)self;
-
-    if (x1 >= dst->width) return;
-    if (y1 > dst->height) y1 = dst->height;
-    if (y2 > dst->height) y2 = dst->height;
-
-	r = RTGUI_RGB_R(dst->gc.foreground);
-	g = RTGUI_RGB_G(dst->gc.foreground);
-	b = RTGUI_RGB_B(dst->gc.foreground);
-	a = RTGUI_RGB_A(dst->gc.foreground);
-
-	switch (dst->pixel_format)
-	{
-	case RTGRAPHIC_PIXEL_FORMAT_RGB565:
-		VLINE(rt_uint16_t, DRAW_SETPIXEL_RGB565, 0);
-		break;
-	case RTGRAPHIC_PIXEL_FORMAT_BGR565:
-		VLINE(rt_uint16_t, DRAW_SETPIXEL_BGR565, 0);
-		break;
-	case RTGRAPHIC_PIXEL_FORMAT_RGB888:
-		VLINE(rt_uint16_t, DRAW_SETPIXEL_RGB888, 0);
-		break;
-	case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
-		VLINE(rt_uint32_t, DRAW_SETPIXEL_ARGB8888, 0);
-		break;
-	}
-}
-
-static void rtgui_dc_buffer_draw_hline(struct rtgui_dc *self, int x1, int x2, int y1)
-{
-    struct rtgui_dc_buffer *dst;
-    unsigned r, g, b, a;
-
-    dst = (struct rtgui_dc_buffer *)self;
-
-    if (y1 >= dst->height) return;
-    if (x1 > dst->width) x1 = dst->width;
-    if (x2 > dst->width) x2 = dst->width;
-
-	r = RTGUI_RGB_R(dst->gc.foreground);
-	g = RTGUI_RGB_G(dst->gc.foreground);
-	b = RTGUI_RGB_B(dst->gc.foreground);
-	a = RTGUI_RGB_A(dst->gc.foreground);
-
-	switch (dst->pixel_format)
-	{
-	case RTGRAPHIC_PIXEL_FORMAT_RGB565:
-		HLINE(rt_uint16_t, DRAW_SETPIXEL_RGB565, 0);
-		break;
-	case RTGRAPHIC_PIXEL_FORMAT_BGR565:
-		HLINE(rt_uint16_t, DRAW_SETPIXEL_BGR565, 0);
-		break;
-	case RTGRAPHIC_PIXEL_FORMAT_RGB888:
-		HLINE(rt_uint16_t, DRAW_SETPIXEL_RGB888, 0);
-		break;
-	case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
-		HLINE(rt_uint32_t, DRAW_SETPIXEL_ARGB8888, 0);
-		break;
-	}
-}
-
-static void rtgui_dc_buffer_fill_rect(struct rtgui_dc *self, struct rtgui_rect *dst_rect)
-{
-    struct rtgui_dc_buffer *dst;
-	unsigned r, g, b, a;
-	rtgui_rect_t _r, *rect;
-
-    RT_ASSERT(self);
-	if (dst_rect == RT_NULL) rtgui_dc_get_rect(self, &_r);
-	else _r = *dst_rect;
-
-    dst = (struct rtgui_dc_buffer *)self;
-
-	/* parameter checking */
-    if (_r.x1 > dst->width)
-        return;
-    else if (_r.x1 < 0)
-        _r.x1 = 0;
-    if (_r.x2 > dst->width)
-        _r.x2 = dst->width;
-
-    if (_r.y1 > dst->height)
-        return;
-    else if (_r.y1 < 0)
-        _r.y1 = 0;
-    if (_r.y2 > dst->height)
-        _r.y2 = dst->height;
-	rect = &_r;
-
-	r = RTGUI_RGB_R(dst->gc.background);
-	g = RTGUI_RGB_G(dst->gc.background);
-	b = RTGUI_RGB_B(dst->gc.background);
-	a = RTGUI_RGB_A(dst->gc.background);
-
-	switch (dst->pixel_format)
-	{
-		case RTGRAPHIC_PIXEL_FORMAT_RGB565:
-			FILLRECT(rt_uint16_t, DRAW_SETPIXEL_RGB565);
-			break;
-		case RTGRAPHIC_PIXEL_FORMAT_BGR565:
-			FILLRECT(rt_uint16_t, DRAW_SETPIXEL_BGR565);
-			break;
-		case RTGRAPHIC_PIXEL_FORMAT_RGB888:
-			FILLRECT(rt_uint32_t, DRAW_SETPIXEL_RGB888);
-			break;
-		case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
-			FILLRECT(rt_uint32_t, DRAW_SETPIXEL_ARGB8888);
-			break;
-	}
-}
-
 /* blit a dc to another dc */
 static void rtgui_dc_buffer_blit(struct rtgui_dc *self, struct rtgui_point *dc_pt, struct rtgui_dc *dest, rtgui_rect_t *rect)
 {
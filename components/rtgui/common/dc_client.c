@@ -33,6 +33,8 @@ static void rtgui_dc_client_draw_vline(struct rtgui_dc *dc, int x, int y1, int y
 static void rtgui_dc_client_fill_rect(struct rtgui_dc *dc, rtgui_rect_t *rect);
 static void rtgui_dc_client_blit_line(struct rtgui_dc *self, int x1, int x2, int y, rt_uint8_t *line_data);
 static void rtgui_dc_client_blit(struct rtgui_dc *dc, struct rtgui_point *dc_point, struct rtgui_dc *dest, rtgui_rect_t *rect);
+static void rtgui_dc_client_blit_mono(struct rtgui_dc *dc, int x, int y, int w, int h,
+                                      const rt_uint8_t *mask, int pitch, rt_bool_t background);
 static rt_bool_t rtgui_dc_client_fini(struct rtgui_dc *dc);
 
 #define hw_driver               (rtgui_graphic_driver_get_default())
@@ -49,6 +51,7 @@ const struct rtgui_dc_engine dc_client_engine =
     rtgui_dc_client_fill_rect,
     rtgui_dc_client_blit_line,
     rtgui_dc_client_blit,
+    rtgui_dc_client_blit_mono,
 
     rtgui_dc_client_fini,
 };
@@ -166,7 +169,7 @@ static void rtgui_dc_client_draw_vline(struct rtgui_dc *self, int x, int y1, int
 	        rtgui_rect_t *prect;
 	        register rt_base_t draw_y1, draw_y2;
 
-	        prect = ((rtgui_rect_t *)(owner->clip.data + index + 1));
+	        prect = ((rtgui_rect_t *)(owner->clip.data + 1)) + index;
 	        draw_y1 = y1;
 	        draw_y2 = y2;
 
@@ -226,7 +229,7 @@ static void rtgui_dc_client_draw_hline(struct rtgui_dc *self, int x1, int x2, in
             rtgui_rect_t *prect;
             register rt_base_t draw_x1, draw_x2;
 
-            prect = ((rtgui_rect_t *)(owner->clip.data + index + 1));
+            prect = ((rtgui_rect_t *)(owner->clip.data + 1)) + index;
             draw_x1 = x1;
             draw_x2 = x2;
 
@@ -245,7 +248,7 @@ static void rtgui_dc_client_draw_hline(struct rtgui_dc *self, int x1, int x2, in
 
 static void rtgui_dc_client_fill_rect(struct rtgui_dc *self, struct rtgui_rect *rect)
 {
-    rtgui_color_t foreground;
+    rtgui_rect_t fill_rect;
     register rt_base_t index;
     rtgui_widget_t *owner;
 
@@ -257,20 +260,43 @@ static void rtgui_dc_client_fill_rect(struct rtgui_dc *self, struct rtgui_rect *
     /* get owner */
     owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
 
-    /* save foreground color */
-    foreground = owner->gc.foreground;
+    /* convert logic to device */
+    fill_rect = *rect;
+    if (fill_rect.x1 > fill_rect.x2) _int_swap(fill_rect.x1, fill_rect.x2);
+    rtgui_rect_moveto(&fill_rect, owner->extent.x1, owner->extent.y1);
 
-    /* set background color as foreground color */
-    owner->gc.foreground = owner->gc.background;
+    /* intersect with the clip extents once instead of on each scanline */
+    rtgui_rect_intersect(&(owner->clip.extents), &fill_rect);
+    if (fill_rect.x1 >= fill_rect.x2 || fill_rect.y1 >= fill_rect.y2) return;
 
-    /* fill rect */
-    for (index = rect->y1; index < rect->y2; index ++)
+    if (owner->clip.data == RT_NULL)
     {
-        rtgui_dc_client_draw_hline(self, rect->x1, rect->x2, index);
+        /* fill rect with background color */
+        rtgui_graphic_driver_fill_rect(hw_driver, &(owner->gc.background), &fill_rect);
     }
+    else
+    {
+        for (index = 0; index < rtgui_region_num_rects(&(owner->clip)); index ++)
+        {
+            rtgui_rect_t *prect;
+            rtgui_rect_t draw_rect;
 
-    /* restore foreground color */
-    owner->gc.foreground = foreground;
+            prect = ((rtgui_rect_t *)(owner->clip.data + 1)) + index;
+
+            /* the boxes of region are sorted in y-x bands */
+            if (prect->y1 >= fill_rect.y2) break;
+
+            /* calculate rect clip */
+            if (prect->y2 <= fill_rect.y1 || prect->x2 <= fill_rect.x1 ||
+                prect->x1 >= fill_rect.x2) continue;
+
+            draw_rect = fill_rect;
+            rtgui_rect_intersect(prect, &draw_rect);
+
+            /* fill rect with background color */
+            rtgui_graphic_driver_fill_rect(hw_driver, &(owner->gc.background), &draw_rect);
+        }
+    }
 }
 
 static void rtgui_dc_client_blit_line(struct rtgui_dc *self, int x1, int x2, int y, rt_uint8_t *line_data)
@@ -318,7 +344,7 @@ static void rtgui_dc_client_blit_line(struct rtgui_dc *self, int x1, int x2, int
             rtgui_rect_t *prect;
             register rt_base_t draw_x1, draw_x2;
 
-            prect = ((rtgui_rect_t *)(owner->clip.data + index + 1));
+            prect = ((rtgui_rect_t *)(owner->clip.data + 1)) + index;
             draw_x1 = x1;
             draw_x2 = x2;
 
@@ -335,6 +361,64 @@ static void rtgui_dc_client_blit_line(struct rtgui_dc *self, int x1, int x2, int
     }
 }
 
+/*
+ * draw 1bpp mask, the clip is tested once for the mask
+ */
+static void rtgui_dc_client_blit_mono(struct rtgui_dc *self, int x, int y, int w, int h,
+                                      const rt_uint8_t *mask, int pitch, rt_bool_t background)
+{
+    int i, j, end;
+    rtgui_rect_t rect;
+    rtgui_widget_t *owner;
+    const rt_uint8_t *row;
+
+    if (self == RT_NULL) return;
+	if (!rtgui_dc_get_visible(self)) return;
+
+    /* get owner */
+    owner = RTGUI_CONTAINER_OF(self, struct rtgui_widget, dc_type);
+
+    /* convert logic to device */
+    rect.x1 = x + owner->extent.x1;
+    rect.y1 = y + owner->extent.y1;
+    rect.x2 = rect.x1 + w;
+    rect.y2 = rect.y1 + h;
+
+    if (owner->clip.data == RT_NULL)
+    {
+        rtgui_rect_intersect(&(owner->clip.extents), &rect);
+        if (rect.x1 >= rect.x2 || rect.y1 >= rect.y2) return;
+    }
+    else
+    {
+        switch (rtgui_region_contains_rectangle(&(owner->clip), &rect))
+        {
+        case RTGUI_REGION_OUT:
+            return;
+        case RTGUI_REGION_PART:
+            /* clip each run */
+            rtgui_dc_blit_mono_runs(self, x, y, w, h, mask, pitch, background);
+            return;
+        }
+    }
+
+    /* the mask in device */
+    x = x + owner->extent.x1;
+    y = y + owner->extent.y1;
+    for (i = rect.y1; i < rect.y2; i ++)
+    {
+        row = mask + (i - y) * pitch;
+        for (j = rect.x1 - x; j < rect.x2 - x; j = end)
+        {
+            end = rtgui_dc_mono_run(row, j, rect.x2 - x);
+            if (row[j >> 3] & (0x80 >> (j & 0x07)))
+                hw_driver->ops->draw_hline(&(owner->gc.foreground), x + j, x + end, i);
+            else if (background)
+                hw_driver->ops->draw_hline(&(owner->gc.background), x + j, x + end, i);
+        }
+    }
+}
+
 static void rtgui_dc_client_blit(struct rtgui_dc *dc, struct rtgui_point *dc_point, struct rtgui_dc *dest, rtgui_rect_t *rect)
 {
     /* not blit in hardware dc */
@@ -30,6 +30,8 @@ static void rtgui_dc_hw_draw_vline(struct rtgui_dc *dc, int x, int y1, int y2);
 static void rtgui_dc_hw_fill_rect(struct rtgui_dc *dc, rtgui_rect_t *rect);
 static void rtgui_dc_hw_blit_line(struct rtgui_dc *self, int x1, int x2, int y, rt_uint8_t *line_data);
 static void rtgui_dc_hw_blit(struct rtgui_dc *dc, struct rtgui_point *dc_point, struct rtgui_dc *dest, rtgui_rect_t *rect);
+static void rtgui_dc_hw_blit_mono(struct rtgui_dc *dc, int x, int y, int w, int h,
+                                  const rt_uint8_t *mask, int pitch, rt_bool_t background);
 static rt_bool_t rtgui_dc_hw_fini(struct rtgui_dc *dc);
 
 const struct rtgui_dc_engine dc_hw_engine =
@@ -41,6 +43,7 @@ const struct rtgui_dc_engine dc_hw_engine =
     rtgui_dc_hw_fill_rect,
     rtgui_dc_hw_blit_line,
     rtgui_dc_hw_blit,
+    rtgui_dc_hw_blit_mono,
 
     rtgui_dc_hw_fini,
 };
@@ -187,6 +190,7 @@ static void rtgui_dc_hw_fill_rect(struct rtgui_dc *self, struct rtgui_rect *rect
 {
     rtgui_color_t color;
     register rt_base_t y1, y2, x1, x2;
+    rtgui_rect_t fill_rect;
     struct rtgui_dc_hw *dc;
 
     RT_ASSERT(self != RT_NULL);
@@ -220,10 +224,9 @@ static void rtgui_dc_hw_fill_rect(struct rtgui_dc *self, struct rtgui_rect *rect
         y2 = dc->owner->extent.y2;
 
     /* fill rect */
-    for (; y1 < y2; y1++)
-    {
-        dc->hw_driver->ops->draw_hline(&color, x1, x2, y1);
-    }
+    fill_rect.x1 = x1; fill_rect.y1 = y1;
+    fill_rect.x2 = x2; fill_rect.y2 = y2;
+    rtgui_graphic_driver_fill_rect(dc->hw_driver, &color, &fill_rect);
 }
 
 static void rtgui_dc_hw_blit_line(struct rtgui_dc *self, int x1, int x2, int y, rt_uint8_t *line_data)
@@ -255,6 +258,44 @@ static void rtgui_dc_hw_blit_line(struct rtgui_dc *self, int x1, int x2, int y,
     dc->hw_driver->ops->draw_raw_hline(line_data, x1, x2, y);
 }
 
+static void rtgui_dc_hw_blit_mono(struct rtgui_dc *self, int x, int y, int w, int h,
+                                  const rt_uint8_t *mask, int pitch, rt_bool_t background)
+{
+    int i, j, end;
+    rtgui_rect_t rect;
+    const rt_uint8_t *row;
+    struct rtgui_dc_hw *dc;
+
+    RT_ASSERT(self != RT_NULL);
+    dc = (struct rtgui_dc_hw *) self;
+
+    /* convert logic to device */
+    x = x + dc->owner->extent.x1;
+    y = y + dc->owner->extent.y1;
+    rect.x1 = x;
+    rect.y1 = y;
+    rect.x2 = x + w;
+    rect.y2 = y + h;
+
+    /* clip to the owner once */
+    rtgui_rect_intersect(&(dc->owner->extent), &rect);
+    if (rect.x1 >= rect.x2 || rect.y1 >= rect.y2)
+        return;
+
+    for (i = rect.y1; i < rect.y2; i ++)
+    {
+        row = mask + (i - y) * pitch;
+        for (j = rect.x1 - x; j < rect.x2 - x; j = end)
+        {
+            end = rtgui_dc_mono_run(row, j, rect.x2 - x);
+            if (row[j >> 3] & (0x80 >> (j & 0x07)))
+                dc->hw_driver->ops->draw_hline(&(dc->owner->gc.foreground), x + j, x + end, i);
+            else if (background)
+                dc->hw_driver->ops->draw_hline(&(dc->owner->gc.background), x + j, x + end, i);
+        }
+    }
+}
+
 static void rtgui_dc_hw_blit(struct rtgui_dc *dc,
                              struct rtgui_point *dc_point,
                              struct rtgui_dc *dest,
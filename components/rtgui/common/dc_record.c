@@ -0,0 +1,385 @@
+/*
+ * File      : dc_record.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2013, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ */
+#include <rtgui/rtgui.h>
+#include <rtgui/dc.h>
+#include <rtgui/dc_record.h>
+#include <rtgui/blit.h>
+#include <rtgui/color.h>
+#include <rtgui/rtgui_system.h>
+
+static rt_bool_t rtgui_dc_record_fini(struct rtgui_dc *dc);
+static void rtgui_dc_record_draw_point(struct rtgui_dc *dc, int x, int y);
+static void rtgui_dc_record_draw_color_point(struct rtgui_dc *dc, int x, int y, rtgui_color_t color);
+static void rtgui_dc_record_draw_vline(struct rtgui_dc *dc, int x, int y1, int y2);
+static void rtgui_dc_record_draw_hline(struct rtgui_dc *dc, int x1, int x2, int y);
+static void rtgui_dc_record_fill_rect(struct rtgui_dc *dc, struct rtgui_rect *rect);
+static void rtgui_dc_record_blit_line(struct rtgui_dc *self, int x1, int x2, int y, rt_uint8_t *line_data);
+
+const static struct rtgui_dc_engine dc_record_engine =
+{
+    rtgui_dc_record_draw_point,
+    rtgui_dc_record_draw_color_point,
+    rtgui_dc_record_draw_vline,
+    rtgui_dc_record_draw_hline,
+    rtgui_dc_record_fill_rect,
+    rtgui_dc_record_blit_line,
+    rtgui_dc_record_replay,
+    RT_NULL,
+
+    rtgui_dc_record_fini,
+};
+
+#define _int_swap(x, y)         do {x ^= y; y ^= x; x ^= y;} while (0)
+
+/* the arena grows from this size */
+#define RECORD_ARENA_MIN        256
+#define RECORD_NO_CMD           0xFFFFFFFF
+#define RECORD_ALIGN(size)      (((size) + sizeof(rtgui_color_t) - 1) & ~(sizeof(rtgui_color_t) - 1))
+
+enum _record_cmd_type
+{
+    RECORD_HLINE,
+    RECORD_VLINE,
+    RECORD_FILL_RECT,
+    RECORD_BLIT_LINE,
+};
+
+struct _record_cmd
+{
+    rtgui_color_t color;
+
+    rt_uint16_t type;
+    /* size of command with the payload */
+    rt_uint16_t size;
+
+    rt_int16_t x1, y1, x2, y2;
+};
+
+#define _record_cmd_at(dc, offset)  ((struct _record_cmd *)((dc)->arena + (offset)))
+
+struct rtgui_dc *rtgui_dc_record_create(int w, int h)
+{
+    struct rtgui_dc_record *dc;
+
+    dc = (struct rtgui_dc_record *)rtgui_malloc(sizeof(struct rtgui_dc_record));
+    if (dc == RT_NULL)
+        return RT_NULL;
+
+    dc->parent.type   = RTGUI_DC_RECORD;
+    dc->parent.engine = &dc_record_engine;
+    dc->gc.foreground = default_foreground;
+    dc->gc.background = default_background;
+    dc->gc.font = rtgui_font_default();
+    dc->gc.textalign = RTGUI_ALIGN_LEFT | RTGUI_ALIGN_TOP;
+    dc->gc.textstyle = RTGUI_TEXTSTYLE_NORMAL;
+    /* record the line data in hardware pixel format */
+    dc->pixel_format = rtgui_graphic_driver_get_default()->pixel_format;
+
+    dc->width  = w;
+    dc->height = h;
+
+    dc->arena = RT_NULL;
+    dc->arena_size = 0;
+    dc->arena_used = 0;
+    dc->last_cmd = RECORD_NO_CMD;
+
+    return &(dc->parent);
+}
+RTM_EXPORT(rtgui_dc_record_create);
+
+void rtgui_dc_record_reset(struct rtgui_dc *dc)
+{
+    struct rtgui_dc_record *record = (struct rtgui_dc_record *)dc;
+
+    RT_ASSERT(dc != RT_NULL && dc->type == RTGUI_DC_RECORD);
+
+    record->arena_used = 0;
+    record->last_cmd = RECORD_NO_CMD;
+}
+RTM_EXPORT(rtgui_dc_record_reset);
+
+rt_uint32_t rtgui_dc_record_get_size(struct rtgui_dc *dc)
+{
+    RT_ASSERT(dc != RT_NULL && dc->type == RTGUI_DC_RECORD);
+
+    return ((struct rtgui_dc_record *)dc)->arena_used;
+}
+RTM_EXPORT(rtgui_dc_record_get_size);
+
+static rt_bool_t rtgui_dc_record_fini(struct rtgui_dc *dc)
+{
+    struct rtgui_dc_record *record = (struct rtgui_dc_record *)dc;
+
+    if (dc->type != RTGUI_DC_RECORD) return RT_FALSE;
+
+    rtgui_free(record->arena);
+    record->arena = RT_NULL;
+    record->arena_size = record->arena_used = 0;
+
+    return RT_TRUE;
+}
+
+/* append a command with payload of size bytes to the arena */
+static struct _record_cmd *_record_append(struct rtgui_dc_record *dc, int type,
+                                          rtgui_color_t color, rt_size_t size)
+{
+    struct _record_cmd *cmd;
+
+    size = RECORD_ALIGN(sizeof(struct _record_cmd) + size);
+    if (size > RT_UINT16_MAX)
+        return RT_NULL;
+
+    if (dc->arena_used + size > dc->arena_size)
+    {
+        rt_uint8_t *arena;
+        rt_uint32_t arena_size;
+
+        arena_size = dc->arena_size ? dc->arena_size : RECORD_ARENA_MIN;
+        while (arena_size < dc->arena_used + size)
+            arena_size *= 2;
+
+        arena = rtgui_realloc(dc->arena, arena_size);
+        if (arena == RT_NULL)
+            return RT_NULL;
+
+        dc->arena = arena;
+        dc->arena_size = arena_size;
+    }
+
+    cmd = _record_cmd_at(dc, dc->arena_used);
+    cmd->color = color;
+    cmd->type = type;
+    cmd->size = size;
+
+    dc->last_cmd = dc->arena_used;
+    dc->arena_used += size;
+
+    return cmd;
+}
+
+static void _record_hline(struct rtgui_dc_record *dc, rtgui_color_t color, int x1, int x2, int y)
+{
+    struct _record_cmd *cmd;
+
+    if (x1 > x2) _int_swap(x1, x2);
+
+    /* the points of text and the adjacent spans are merged into one run */
+    if (dc->last_cmd != RECORD_NO_CMD)
+    {
+        cmd = _record_cmd_at(dc, dc->last_cmd);
+        if (cmd->type == RECORD_HLINE && cmd->color == color && cmd->y1 == y &&
+            x1 <= cmd->x2 && x2 >= cmd->x1)
+        {
+            if (x1 < cmd->x1) cmd->x1 = x1;
+            if (x2 > cmd->x2) cmd->x2 = x2;
+            return;
+        }
+    }
+
+    cmd = _record_append(dc, RECORD_HLINE, color, 0);
+    if (cmd == RT_NULL) return;
+
+    cmd->x1 = x1; cmd->x2 = x2;
+    cmd->y1 = y;  cmd->y2 = y + 1;
+}
+
+static void rtgui_dc_record_draw_point(struct rtgui_dc *self, int x, int y)
+{
+    struct rtgui_dc_record *dc = (struct rtgui_dc_record *)self;
+
+    _record_hline(dc, dc->gc.foreground, x, x + 1, y);
+}
+
+static void rtgui_dc_record_draw_color_point(struct rtgui_dc *self, int x, int y, rtgui_color_t color)
+{
+    struct rtgui_dc_record *dc = (struct rtgui_dc_record *)self;
+
+    _record_hline(dc, color, x, x + 1, y);
+}
+
+static void rtgui_dc_record_draw_hline(struct rtgui_dc *self, int x1, int x2, int y)
+{
+    struct rtgui_dc_record *dc = (struct rtgui_dc_record *)self;
+
+    _record_hline(dc, dc->gc.foreground, x1, x2, y);
+}
+
+static void rtgui_dc_record_draw_vline(struct rtgui_dc *self, int x, int y1, int y2)
+{
+    struct _record_cmd *cmd;
+    struct rtgui_dc_record *dc = (struct rtgui_dc_record *)self;
+
+    if (y1 > y2) _int_swap(y1, y2);
+
+    if (dc->last_cmd != RECORD_NO_CMD)
+    {
+        cmd = _record_cmd_at(dc, dc->last_cmd);
+        if (cmd->type == RECORD_VLINE && cmd->color == dc->gc.foreground &&
+            cmd->x1 == x && y1 <= cmd->y2 && y2 >= cmd->y1)
+        {
+            if (y1 < cmd->y1) cmd->y1 = y1;
+            if (y2 > cmd->y2) cmd->y2 = y2;
+            return;
+        }
+    }
+
+    cmd = _record_append(dc, RECORD_VLINE, dc->gc.foreground, 0);
+    if (cmd == RT_NULL) return;
+
+    cmd->x1 = x;  cmd->x2 = x + 1;
+    cmd->y1 = y1; cmd->y2 = y2;
+}
+
+static void rtgui_dc_record_fill_rect(struct rtgui_dc *self, struct rtgui_rect *rect)
+{
+    struct _record_cmd *cmd;
+    struct rtgui_dc_record *dc = (struct rtgui_dc_record *)self;
+
+    cmd = _record_append(dc, RECORD_FILL_RECT, dc->gc.background, 0);
+    if (cmd == RT_NULL) return;
+
+    if (rect == RT_NULL)
+    {
+        cmd->x1 = 0; cmd->x2 = dc->width;
+        cmd->y1 = 0; cmd->y2 = dc->height;
+    }
+    else
+    {
+        cmd->x1 = rect->x1; cmd->x2 = rect->x2;
+        cmd->y1 = rect->y1; cmd->y2 = rect->y2;
+    }
+}
+
+static void rtgui_dc_record_blit_line(struct rtgui_dc *self, int x1, int x2, int y, rt_uint8_t *line_data)
+{
+    rt_size_t size;
+    struct _record_cmd *cmd;
+    struct rtgui_dc_record *dc = (struct rtgui_dc_record *)self;
+
+    if (x1 > x2) _int_swap(x1, x2);
+
+    size = (x2 - x1) * rtgui_color_get_bpp(dc->pixel_format);
+    cmd = _record_append(dc, RECORD_BLIT_LINE, 0, size);
+    if (cmd == RT_NULL) return;
+
+    cmd->x1 = x1; cmd->x2 = x2;
+    cmd->y1 = y;  cmd->y2 = y + 1;
+    rt_memcpy(cmd + 1, line_data, size);
+}
+
+void rtgui_dc_record_replay(struct rtgui_dc *self, struct rtgui_point *dc_point,
+                            struct rtgui_dc *dest, rtgui_rect_t *rect)
+{
+    int dx, dy;
+    rt_uint32_t offset;
+    rtgui_rect_t clip;
+    rtgui_color_t foreground, background;
+    rt_uint8_t *line_buf = RT_NULL;
+    rtgui_blit_line_func blit_line = RT_NULL;
+    int src_bpp, dst_bpp;
+    struct rtgui_dc_record *dc = (struct rtgui_dc_record *)self;
+
+    RT_ASSERT(self != RT_NULL && self->type == RTGUI_DC_RECORD);
+    RT_ASSERT(dest != RT_NULL);
+
+    if (rtgui_dc_get_visible(dest) == RT_FALSE)
+        return;
+
+    if (rect == RT_NULL)
+        rtgui_dc_get_rect(dest, &clip);
+    else
+        clip = *rect;
+
+    /* the offset from record to dest */
+    dx = clip.x1;
+    dy = clip.y1;
+    if (dc_point != RT_NULL)
+    {
+        dx -= dc_point->x;
+        dy -= dc_point->y;
+    }
+
+    /* clip to the record area on dest */
+    if (clip.x2 > dx + dc->width)  clip.x2 = dx + dc->width;
+    if (clip.y2 > dy + dc->height) clip.y2 = dy + dc->height;
+    if (clip.x1 < dx) clip.x1 = dx;
+    if (clip.y1 < dy) clip.y1 = dy;
+    if (clip.x1 >= clip.x2 || clip.y1 >= clip.y2)
+        return;
+
+    src_bpp = rtgui_color_get_bpp(dc->pixel_format);
+    dst_bpp = rtgui_color_get_bpp(rtgui_dc_get_pixel_format(dest));
+
+    foreground = RTGUI_DC_FC(dest);
+    background = RTGUI_DC_BC(dest);
+
+    for (offset = 0; offset < dc->arena_used; offset += _record_cmd_at(dc, offset)->size)
+    {
+        rtgui_rect_t r;
+        struct _record_cmd *cmd = _record_cmd_at(dc, offset);
+
+        r.x1 = cmd->x1 + dx; r.x2 = cmd->x2 + dx;
+        r.y1 = cmd->y1 + dy; r.y2 = cmd->y2 + dy;
+        rtgui_rect_intersect(&clip, &r);
+        if (r.x1 >= r.x2 || r.y1 >= r.y2)
+            continue;
+
+        switch (cmd->type)
+        {
+        case RECORD_HLINE:
+            RTGUI_DC_FC(dest) = cmd->color;
+            rtgui_dc_draw_hline(dest, r.x1, r.x2, r.y1);
+            break;
+
+        case RECORD_VLINE:
+            RTGUI_DC_FC(dest) = cmd->color;
+            rtgui_dc_draw_vline(dest, r.x1, r.y1, r.y2);
+            break;
+
+        case RECORD_FILL_RECT:
+            RTGUI_DC_BC(dest) = cmd->color;
+            rtgui_dc_fill_rect(dest, &r);
+            break;
+
+        case RECORD_BLIT_LINE:
+        {
+            rt_uint8_t *line_data;
+
+            line_data = (rt_uint8_t *)(cmd + 1) + (r.x1 - dx - cmd->x1) * src_bpp;
+            if (src_bpp != dst_bpp)
+            {
+                /* convert to the pixel format of dest */
+                if (line_buf == RT_NULL)
+                {
+                    blit_line = rtgui_blit_line_get(dst_bpp, src_bpp);
+                    if (blit_line == RT_NULL)
+                        goto __exit;
+                    line_buf = rtgui_malloc(dc->width * dst_bpp);
+                    /* no line can be drawn without the buffer */
+                    if (line_buf == RT_NULL)
+                        goto __exit;
+                }
+                blit_line(line_buf, line_data, (r.x2 - r.x1) * src_bpp);
+                line_data = line_buf;
+            }
+            dest->engine->blit_line(dest, r.x1, r.x2, r.y1, line_data);
+            break;
+        }
+        }
+    }
+
+__exit:
+    if (line_buf != RT_NULL)
+        rtgui_free(line_buf);
+
+    RTGUI_DC_FC(dest) = foreground;
+    RTGUI_DC_BC(dest) = background;
+}
+RTM_EXPORT(rtgui_dc_record_replay);
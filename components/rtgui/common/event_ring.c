@@ -0,0 +1,174 @@
+/*
+ * File      : event_ring.c
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2013, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ */
+#include <rtgui/rtgui.h>
+#include <rtgui/event_ring.h>
+#include <rtgui/rtgui_system.h>
+
+#if defined(__GNUC__)
+#define _ring_cas(ptr, old, value)  __sync_bool_compare_and_swap((ptr), (old), (value))
+#define _ring_barrier()             __sync_synchronize()
+#else
+/* on the compilers without atomic builtins, do the compare and swap with
+ * interrupt disabled. It's still lock free for the threads. */
+rt_inline rt_bool_t _ring_cas(volatile rt_uint32_t *ptr, rt_uint32_t old, rt_uint32_t value)
+{
+    rt_base_t level;
+    rt_bool_t result = RT_FALSE;
+
+    level = rt_hw_interrupt_disable();
+    if (*ptr == old)
+    {
+        *ptr = value;
+        result = RT_TRUE;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return result;
+}
+#define _ring_barrier()
+#endif
+
+rt_err_t rtgui_event_ring_init(struct rtgui_event_ring *ring, const char *name, rt_uint32_t size)
+{
+    rt_uint32_t index;
+
+    RT_ASSERT(ring != RT_NULL);
+    /* the index is masked with size - 1 */
+    RT_ASSERT(size != 0 && (size & (size - 1)) == 0);
+
+    ring->slots = rtgui_malloc(sizeof(struct rtgui_event_ring_slot) * size);
+    if (ring->slots == RT_NULL)
+        return -RT_ENOMEM;
+
+    for (index = 0; index < size; index ++)
+        ring->slots[index].seq = index;
+
+    ring->size   = size;
+    ring->head   = 0;
+    ring->tail   = 0;
+    ring->parked = 0;
+    rt_sem_init(&ring->sem, name, 0, RT_IPC_FLAG_FIFO);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rtgui_event_ring_init);
+
+void rtgui_event_ring_fini(struct rtgui_event_ring *ring)
+{
+    RT_ASSERT(ring != RT_NULL);
+
+    rt_sem_detach(&ring->sem);
+    rtgui_free(ring->slots);
+    ring->slots = RT_NULL;
+}
+RTM_EXPORT(rtgui_event_ring_fini);
+
+rt_err_t rtgui_event_ring_put(struct rtgui_event_ring *ring, rtgui_event_t *event, rt_size_t event_size)
+{
+    rt_uint32_t pos;
+    rt_int32_t dif;
+    struct rtgui_event_ring_slot *slot;
+
+    RT_ASSERT(ring != RT_NULL);
+    RT_ASSERT(event != RT_NULL);
+    RT_ASSERT(event_size <= sizeof(union rtgui_event_generic));
+
+    pos = ring->head;
+    while (1)
+    {
+        slot = &ring->slots[pos & (ring->size - 1)];
+        dif = (rt_int32_t)(slot->seq - pos);
+        if (dif == 0)
+        {
+            /* the slot is free, claim it */
+            if (_ring_cas(&ring->head, pos, pos + 1))
+                break;
+            pos = ring->head;
+        }
+        else if (dif < 0)
+        {
+            /* the receiver has not read the slot of last turn */
+            return -RT_EFULL;
+        }
+        else
+        {
+            /* another sender has claimed it */
+            pos = ring->head;
+        }
+    }
+
+    rt_memcpy(&slot->event, event, event_size);
+    /* publish the event after it's written */
+    _ring_barrier();
+    slot->seq = pos + 1;
+    _ring_barrier();
+
+    /* wake up the receiver only if it's waiting */
+    if (ring->parked && _ring_cas(&ring->parked, 1, 0))
+        rt_sem_release(&ring->sem);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rtgui_event_ring_put);
+
+rt_inline rt_err_t _rtgui_event_ring_pop(struct rtgui_event_ring *ring,
+                                         rtgui_event_t *event, rt_size_t event_size)
+{
+    struct rtgui_event_ring_slot *slot;
+
+    slot = &ring->slots[ring->tail & (ring->size - 1)];
+    if (slot->seq != ring->tail + 1)
+        return -RT_EEMPTY;
+    _ring_barrier();
+
+    rt_memcpy(event, &slot->event, event_size);
+    _ring_barrier();
+    /* free the slot for the next turn */
+    slot->seq = ring->tail + ring->size;
+    ring->tail ++;
+
+    return RT_EOK;
+}
+
+rt_err_t rtgui_event_ring_get(struct rtgui_event_ring *ring, rtgui_event_t *event, rt_size_t event_size,
+                              rt_int32_t timeout)
+{
+    rt_err_t result;
+
+    RT_ASSERT(ring != RT_NULL);
+    RT_ASSERT(event != RT_NULL);
+    RT_ASSERT(event_size <= sizeof(union rtgui_event_generic));
+
+    while (1)
+    {
+        if (_rtgui_event_ring_pop(ring, event, event_size) == RT_EOK)
+            return RT_EOK;
+
+        if (timeout == 0)
+            return -RT_ETIMEOUT;
+
+        /* park, and check again for the event put before the flag is seen */
+        ring->parked = 1;
+        _ring_barrier();
+        if (_rtgui_event_ring_pop(ring, event, event_size) == RT_EOK)
+        {
+            ring->parked = 0;
+            return RT_EOK;
+        }
+
+        /* a release left by a sender which saw the flag of last parking only
+         * wakes up this loop once more */
+        result = rt_sem_take(&ring->sem, timeout);
+        ring->parked = 0;
+        if (result != RT_EOK)
+            return result;
+    }
+}
+RTM_EXPORT(rtgui_event_ring_get);
@@ -30,17 +30,16 @@ RTM_EXPORT(bmp_font_engine);
 void rtgui_bitmap_font_draw_char(struct rtgui_font_bitmap *font, struct rtgui_dc *dc, const char ch,
                                  rtgui_rect_t *rect)
 {
-    rtgui_color_t bc;
     const rt_uint8_t *font_ptr;
-    rt_uint16_t x, y, w, h, style;
-    register rt_base_t i, j, /*k,*/ word_bytes;
+    int x, y, w, h;
+    rt_uint16_t style;
+    rt_base_t word_bytes;
 
     /* check first and last char */
     if (ch < font->first_char || ch > font->last_char) return;
 
     /* get text style */
     style = rtgui_dc_get_gc(dc)->textstyle;
-    bc = rtgui_dc_get_gc(dc)->background;
 
     x = rect->x1;
     y = rect->y1;
@@ -57,22 +56,12 @@ void rtgui_bitmap_font_draw_char(struct rtgui_font_bitmap *font, struct rtgui_dc
     }
     w = (font->width  + x > rect->x2) ? rect->x2 - rect->x1 : font->width;
     h = (font->height + y > rect->y2) ? rect->y2 - rect->y1 : font->height;
+    /* the glyph of proportional font is narrower than font */
+    if (w > word_bytes * 8) w = word_bytes * 8;
 
-    for (i = 0; i < h; i++)
-    {
-        rt_uint8_t chr = 0;
-        const rt_uint8_t *ptr = font_ptr + i * word_bytes;
-        for (j = 0; j < w; j++)
-        {
-            if (j % 8 == 0)
-                chr = *ptr++;
-            if (chr & 0x80)
-                rtgui_dc_draw_point(dc, j + x, i + y);
-            else if (style & RTGUI_TEXTSTYLE_DRAW_BACKGROUND)
-                rtgui_dc_draw_color_point(dc, j + x, i + y, bc);
-            chr <<= 1;
-        }
-    }
+    /* draw the glyph as a mask */
+    rtgui_dc_blit_mono(dc, x, y, w, h, font_ptr, word_bytes,
+                       (style & RTGUI_TEXTSTYLE_DRAW_BACKGROUND) ? RT_TRUE : RT_FALSE);
 }
 
 static void rtgui_bitmap_font_draw_text(struct rtgui_font *font, struct rtgui_dc *dc,
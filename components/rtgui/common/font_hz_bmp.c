@@ -54,16 +54,14 @@ rt_inline const rt_uint8_t *_rtgui_hz_bitmap_get_font_ptr(struct rtgui_font_bitm
 
 static void _rtgui_hz_bitmap_font_draw_text(struct rtgui_font_bitmap *bmp_font, struct rtgui_dc *dc, const char *text, rt_ubase_t len, struct rtgui_rect *rect)
 {
-    rtgui_color_t bc;
     rt_uint16_t style;
     rt_uint8_t *str;
-    register rt_base_t h, word_bytes, font_bytes;
+    register rt_base_t w, h, word_bytes, font_bytes;
 
     RT_ASSERT(bmp_font != RT_NULL);
 
     /* get text style */
     style = rtgui_dc_get_gc(dc)->textstyle;
-    bc = rtgui_dc_get_gc(dc)->background;
 
     /* drawing height */
     h = (bmp_font->height + rect->y1 > rect->y2) ? rect->y2 - rect->y1 : bmp_font->height;
@@ -75,27 +73,13 @@ static void _rtgui_hz_bitmap_font_draw_text(struct rtgui_font_bitmap *bmp_font,
     while (len > 0 && rect->x1 < rect->x2)
     {
         const rt_uint8_t *font_ptr;
-        register rt_base_t i, j, k;
 
         /* get font pixel data */
         font_ptr = _rtgui_hz_bitmap_get_font_ptr(bmp_font, str, font_bytes);
         /* draw word */
-        for (i = 0; i < h; i ++)
-        {
-            for (j = 0; j < word_bytes; j++)
-                for (k = 0; k < 8; k++)
-                {
-                    if (((font_ptr[i * word_bytes + j] >> (7 - k)) & 0x01) != 0 &&
-                            (rect->x1 + 8 * j + k < rect->x2))
-                    {
-                        rtgui_dc_draw_point(dc, rect->x1 + 8 * j + k, rect->y1 + i);
-                    }
-                    else if (style & RTGUI_TEXTSTYLE_DRAW_BACKGROUND)
-                    {
-                        rtgui_dc_draw_color_point(dc, rect->x1 + 8 * j + k, rect->y1 + i, bc);
-                    }
-                }
-        }
+        w = (word_bytes * 8 + rect->x1 > rect->x2) ? rect->x2 - rect->x1 : word_bytes * 8;
+        rtgui_dc_blit_mono(dc, rect->x1, rect->y1, w, h, font_ptr, word_bytes,
+                           (style & RTGUI_TEXTSTYLE_DRAW_BACKGROUND) ? RT_TRUE : RT_FALSE);
 
         /* move x to next character */
         rect->x1 += bmp_font->width;
@@ -1,111 +1,98 @@
 #include <rtgui/rtgui_system.h>
 #include <rtgui/driver.h>
+#include <rtgui/blit.h>
 #include <string.h>
 
 #define GET_PIXEL(dst, x, y, type)  \
     (type *)((rt_uint8_t*)((dst)->framebuffer) + (y) * (dst)->pitch + (x) * _UI_BITBYTES((dst)->bits_per_pixel))
-
-static void _rgb565_set_pixel(rtgui_color_t *c, int x, int y)
-{
-    *GET_PIXEL(rtgui_graphic_get_device(), x, y, rt_uint16_t) = rtgui_color_to_565(*c);
-}
-
-static void _rgb565_get_pixel(rtgui_color_t *c, int x, int y)
-{
-    rt_uint16_t pixel;
-
-    pixel = *GET_PIXEL(rtgui_graphic_get_device(), x, y, rt_uint16_t);
-
-    /* get pixel from color */
-    *c = rtgui_color_from_565(pixel);
-}
-
-static void _rgb565_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
-{
-    rt_ubase_t index;
-    rt_uint16_t pixel;
-    rt_uint16_t *pixel_ptr;
-
-    /* get pixel from color */
-    pixel = rtgui_color_to_565(*c);
-
-    /* get pixel pointer in framebuffer */
-    pixel_ptr = GET_PIXEL(rtgui_graphic_get_device(), x1, y, rt_uint16_t);
-
-    for (index = x1; index < x2; index ++)
-    {
-        *pixel_ptr = pixel;
-        pixel_ptr ++;
-    }
-}
-
-static void _rgb565_draw_vline(rtgui_color_t *c, int x , int y1, int y2)
-{
-    struct rtgui_graphic_driver *drv;
-    rt_uint8_t *dst;
-    rt_uint16_t pixel;
-    rt_ubase_t index;
-
-    drv = rtgui_graphic_get_device();
-    pixel = rtgui_color_to_565(*c);
-    dst = GET_PIXEL(drv, x, y1, rt_uint8_t);
-    for (index = y1; index < y2; index ++)
-    {
-        *(rt_uint16_t *)dst = pixel;
-        dst += drv->pitch;
-    }
-}
-
-static void _rgb565p_set_pixel(rtgui_color_t *c, int x, int y)
-{
-    *GET_PIXEL(rtgui_graphic_get_device(), x, y, rt_uint16_t) = rtgui_color_to_565p(*c);
-}
-
-static void _rgb565p_get_pixel(rtgui_color_t *c, int x, int y)
-{
-    rt_uint16_t pixel;
-
-    pixel = *GET_PIXEL(rtgui_graphic_get_device(), x, y, rt_uint16_t);
-
-    /* get pixel from color */
-    *c = rtgui_color_from_565p(pixel);
-}
-
-static void _rgb565p_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
-{
-    rt_ubase_t index;
-    rt_uint16_t pixel;
-    rt_uint16_t *pixel_ptr;
-
-    /* get pixel from color */
-    pixel = rtgui_color_to_565p(*c);
-
-    /* get pixel pointer in framebuffer */
-    pixel_ptr = GET_PIXEL(rtgui_graphic_get_device(), x1, y, rt_uint16_t);
-
-    for (index = x1; index < x2; index ++)
-    {
-        *pixel_ptr = pixel;
-        pixel_ptr ++;
-    }
-}
-
-static void _rgb565p_draw_vline(rtgui_color_t *c, int x , int y1, int y2)
-{
-    struct rtgui_graphic_driver *drv;
-    rt_uint8_t *dst;
-    rt_uint16_t pixel;
-    rt_ubase_t index;
-
-    drv = rtgui_graphic_get_device();
-    pixel = rtgui_color_to_565p(*c);
-    dst = GET_PIXEL(drv, x, y1, rt_uint8_t);
-    for (index = y1; index < y2; index ++)
-    {
-        *(rt_uint16_t *)dst = pixel;
-        dst += drv->pitch;
-    }
-}
+/* pixel address with the bytes per pixel known at compile time */
+#define GET_PIXEL_BPP(dst, x, y, bpp)  \
+    ((rt_uint8_t*)((dst)->framebuffer) + (y) * (dst)->pitch + (x) * (bpp))
+
+/* load and store one pixel of 2, 3 (B, G, R) or 4 bytes */
+#define _fb_get_2(ptr)          (*(rt_uint16_t *)(ptr))
+#define _fb_get_3(ptr)          ((ptr)[0] | ((ptr)[1] << 8) | ((ptr)[2] << 16))
+#define _fb_get_4(ptr)          (*(rt_uint32_t *)(ptr))
+#define _fb_set_2(ptr, pixel)   (*(rt_uint16_t *)(ptr) = (rt_uint16_t)(pixel))
+#define _fb_set_3(ptr, pixel)   \
+    do { (ptr)[0] = (pixel) & 0xff; (ptr)[1] = ((pixel) >> 8) & 0xff; (ptr)[2] = ((pixel) >> 16) & 0xff; } while (0)
+#define _fb_set_4(ptr, pixel)   (*(rt_uint32_t *)(ptr) = (rt_uint32_t)(pixel))
+
+#define _argb888_to_pixel(c)    ((rt_uint32_t)(c))
+#define _argb888_from_pixel(p)  ((rtgui_color_t)(p))
+
+/*
+ * The operations of one pixel format. The spans and rects are filled by
+ * rtgui_blit_fill_x with word wide stores, and a rect over whole lines is
+ * filled as one span.
+ */
+#define FRAMEBUFFER_OPS(name, bpp, to_pixel, from_pixel)                        \
+static void _##name##_set_pixel(rtgui_color_t *c, int x, int y)                 \
+{                                                                               \
+    rt_uint8_t *ptr = GET_PIXEL_BPP(rtgui_graphic_get_device(), x, y, bpp);     \
+    _fb_set_##bpp(ptr, to_pixel(*c));                                           \
+}                                                                               \
+                                                                                \
+static void _##name##_get_pixel(rtgui_color_t *c, int x, int y)                 \
+{                                                                               \
+    rt_uint8_t *ptr = GET_PIXEL_BPP(rtgui_graphic_get_device(), x, y, bpp);     \
+    *c = from_pixel(_fb_get_##bpp(ptr));                                        \
+}                                                                               \
+                                                                                \
+static void _##name##_draw_hline(rtgui_color_t *c, int x1, int x2, int y)       \
+{                                                                               \
+    rtgui_blit_fill_##bpp(GET_PIXEL_BPP(rtgui_graphic_get_device(), x1, y, bpp), \
+                          to_pixel(*c), x2 - x1);                               \
+}                                                                               \
+                                                                                \
+static void _##name##_draw_vline(rtgui_color_t *c, int x , int y1, int y2)      \
+{                                                                               \
+    struct rtgui_graphic_driver *drv;                                           \
+    rt_uint32_t pixel;                                                          \
+    rt_uint8_t *dst;                                                            \
+                                                                                \
+    drv = rtgui_graphic_get_device();                                           \
+    pixel = to_pixel(*c);                                                       \
+    dst = GET_PIXEL_BPP(drv, x, y1, bpp);                                       \
+    for (; y1 < y2; y1 ++)                                                      \
+    {                                                                           \
+        _fb_set_##bpp(dst, pixel);                                              \
+        dst += drv->pitch;                                                      \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static void _##name##_fill_rect(rtgui_color_t *c, int x1, int y1, int x2, int y2) \
+{                                                                               \
+    struct rtgui_graphic_driver *drv;                                           \
+    rt_uint32_t pixel;                                                          \
+    rt_uint8_t *dst;                                                            \
+                                                                                \
+    if ((x1 >= x2) || (y1 >= y2)) return;                                       \
+                                                                                \
+    drv = rtgui_graphic_get_device();                                           \
+    pixel = to_pixel(*c);                                                       \
+    dst = GET_PIXEL_BPP(drv, x1, y1, bpp);                                      \
+    if ((x2 - x1) * (bpp) == drv->pitch)                                        \
+    {                                                                           \
+        rtgui_blit_fill_##bpp(dst, pixel, (x2 - x1) * (y2 - y1));               \
+        return;                                                                 \
+    }                                                                           \
+    for (; y1 < y2; y1 ++)                                                      \
+    {                                                                           \
+        rtgui_blit_fill_##bpp(dst, pixel, x2 - x1);                             \
+        dst += drv->pitch;                                                      \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+const struct rtgui_graphic_driver_ops _framebuffer_##name##_ops =               \
+{                                                                               \
+    _##name##_set_pixel,                                                        \
+    _##name##_get_pixel,                                                        \
+    _##name##_draw_hline,                                                       \
+    _##name##_draw_vline,                                                       \
+    framebuffer_draw_raw_hline,                                                 \
+    _##name##_fill_rect,                                                        \
+};
 
 /* draw raw hline */
 static void framebuffer_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y)
@@ -119,23 +106,10 @@ static void framebuffer_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y
               (x2 - x1) * _UI_BITBYTES(drv->bits_per_pixel));
 }
 
-const struct rtgui_graphic_driver_ops _framebuffer_rgb565_ops =
-{
-    _rgb565_set_pixel,
-    _rgb565_get_pixel,
-    _rgb565_draw_hline,
-    _rgb565_draw_vline,
-    framebuffer_draw_raw_hline,
-};
-
-const struct rtgui_graphic_driver_ops _framebuffer_rgb565p_ops =
-{
-    _rgb565p_set_pixel,
-    _rgb565p_get_pixel,
-    _rgb565p_draw_hline,
-    _rgb565p_draw_vline,
-    framebuffer_draw_raw_hline,
-};
+FRAMEBUFFER_OPS(rgb565, 2, rtgui_color_to_565, rtgui_color_from_565)
+FRAMEBUFFER_OPS(rgb565p, 2, rtgui_color_to_565p, rtgui_color_from_565p)
+FRAMEBUFFER_OPS(rgb888, 3, rtgui_color_to_888, rtgui_color_from_888)
+FRAMEBUFFER_OPS(argb888, 4, _argb888_to_pixel, _argb888_from_pixel)
 
 #define FRAMEBUFFER (drv->framebuffer)
 #define MONO_PIXEL(framebuffer, x, y) \
@@ -233,6 +207,10 @@ const struct rtgui_graphic_driver_ops *rtgui_framebuffer_get_ops(int pixel_forma
         return &_framebuffer_rgb565_ops;
     case RTGRAPHIC_PIXEL_FORMAT_RGB565P:
         return &_framebuffer_rgb565p_ops;
+    case RTGRAPHIC_PIXEL_FORMAT_RGB888:
+        return &_framebuffer_rgb888_ops;
+    case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
+        return &_framebuffer_argb888_ops;
     }
 
     return RT_NULL;
@@ -5,6 +5,7 @@
  */
 #include <rtgui/rtgui_system.h>
 #include <rtgui/driver.h>
+#include <rtgui/blit.h>
 
 #define gfx_device      (rtgui_graphic_get_device()->device)
 #define gfx_device_ops  rt_graphix_ops(gfx_device)
@@ -17,6 +18,192 @@ static void _pixel_mono_set_pixel(rtgui_color_t *c, int x, int y)
     gfx_device_ops->set_pixel((char *)&pixel, x, y);
 }
 
+static void _pixel_mono_get_pixel(rtgui_color_t *c, int x, int y)
+{
+    rt_uint8_t pixel;
+
+    gfx_device_ops->get_pixel((char *)&pixel, x, y);
+    *c = rtgui_color_from_mono(pixel);
+}
+
+static void _pixel_mono_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
+{
+    rt_uint8_t pixel;
+
+    pixel = rtgui_color_to_mono(*c);
+    gfx_device_ops->draw_hline((char *)&pixel, x1, x2, y);
+}
+
+static void _pixel_mono_draw_vline(rtgui_color_t *c, int x, int y1, int y2)
+{
+    rt_uint8_t pixel;
+
+    pixel = rtgui_color_to_mono(*c);
+    gfx_device_ops->draw_vline((char *)&pixel, x, y1, y2);
+}
+
+static void _pixel_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y)
+{
+    if (x2 > x1)
+        gfx_device_ops->blit_line((char *)pixels, x1, y, (x2 - x1));
+    else
+        gfx_device_ops->blit_line((char *)pixels, x2, y, (x1 - x2));
+}
+
+/* pixel device */
+const struct rtgui_graphic_driver_ops _pixel_mono_ops =
+{
+    _pixel_mono_set_pixel,
+    _pixel_mono_get_pixel,
+    _pixel_mono_draw_hline,
+    _pixel_mono_draw_vline,
+    _pixel_draw_raw_hline,
+};
+
+#ifdef RTGUI_USING_PIXEL_BATCH
+/*
+ * The writes to pixel device are batched: a pixel or hline which continues
+ * the staged span of a line is appended to it, and the span is written with
+ * one blit_line when a write does not continue it, the staging is full or
+ * the drawing ends.
+ */
+static struct
+{
+    rt_uint8_t pixels[RTGUI_PIXEL_BATCH_SIZE * 4];
+
+    /* the staged span [x1, x2) of line y, x1 == x2 if it is empty */
+    int x1, x2, y;
+    int bpp;
+} _batch;
+static struct rtgui_pixel_batch_stat _batch_stat;
+
+void rtgui_pixel_device_flush(void)
+{
+    if (_batch.x2 > _batch.x1)
+    {
+        gfx_device_ops->blit_line((char *)_batch.pixels, _batch.x1, _batch.y,
+                                  _batch.x2 - _batch.x1);
+        _batch_stat.calls ++;
+    }
+    _batch.x1 = _batch.x2 = 0;
+}
+RTM_EXPORT(rtgui_pixel_device_flush);
+
+void rtgui_pixel_device_get_stat(struct rtgui_pixel_batch_stat *stat)
+{
+    RT_ASSERT(stat != RT_NULL);
+
+    *stat = _batch_stat;
+}
+RTM_EXPORT(rtgui_pixel_device_get_stat);
+
+/* get the staging of count pixels from (x, y). Return RT_NULL when they are
+ * too many, the caller writes them to device directly */
+static rt_uint8_t *_batch_stage(int x, int y, int count, int bpp)
+{
+    rt_uint8_t *ptr;
+
+    _batch_stat.writes ++;
+    if ((_batch.x2 > _batch.x1) && (y == _batch.y) && (x == _batch.x2) &&
+        (bpp == _batch.bpp) && (_batch.x2 - _batch.x1 + count <= RTGUI_PIXEL_BATCH_SIZE))
+    {
+        ptr = _batch.pixels + (x - _batch.x1) * bpp;
+        _batch.x2 += count;
+        return ptr;
+    }
+
+    rtgui_pixel_device_flush();
+    if (count > RTGUI_PIXEL_BATCH_SIZE)
+    {
+        _batch_stat.calls ++;
+        return RT_NULL;
+    }
+
+    _batch.x1 = x;
+    _batch.x2 = x + count;
+    _batch.y  = y;
+    _batch.bpp = bpp;
+    return _batch.pixels;
+}
+
+/* a write which is not batched */
+rt_inline void _batch_direct(void)
+{
+    rtgui_pixel_device_flush();
+    _batch_stat.writes ++;
+    _batch_stat.calls ++;
+}
+
+/*
+ * The batched operations of one pixel format. The pixel is staged as bpp
+ * bytes, in the byte order of blit_line.
+ */
+#define PIXEL_BATCH_OPS(name, bpp, type, to_pixel, from_pixel)                 \
+static void _batch_##name##_set_pixel(rtgui_color_t *c, int x, int y)          \
+{                                                                               \
+    type pixel = to_pixel(*c);                                                  \
+    rt_uint8_t *ptr;                                                            \
+                                                                                \
+    ptr = _batch_stage(x, y, 1, bpp);                                           \
+    rt_memcpy(ptr, &pixel, bpp);                                                \
+}                                                                               \
+                                                                                \
+static void _batch_##name##_get_pixel(rtgui_color_t *c, int x, int y)          \
+{                                                                               \
+    type pixel = 0;                                                             \
+                                                                                \
+    rtgui_pixel_device_flush();                                                 \
+    gfx_device_ops->get_pixel((char *)&pixel, x, y);                            \
+    *c = from_pixel(pixel);                                                     \
+}                                                                               \
+                                                                                \
+static void _batch_##name##_draw_hline(rtgui_color_t *c, int x1, int x2, int y) \
+{                                                                               \
+    type pixel = to_pixel(*c);                                                  \
+    rt_uint8_t *ptr;                                                            \
+                                                                                \
+    if (x1 >= x2) return;                                                       \
+    ptr = _batch_stage(x1, y, x2 - x1, bpp);                                    \
+    if (ptr == RT_NULL)                                                         \
+        gfx_device_ops->draw_hline((char *)&pixel, x1, x2, y);                  \
+    else                                                                        \
+        rtgui_blit_fill_##bpp(ptr, pixel, x2 - x1);                             \
+}                                                                               \
+                                                                                \
+static void _batch_##name##_draw_vline(rtgui_color_t *c, int x, int y1, int y2) \
+{                                                                               \
+    type pixel = to_pixel(*c);                                                  \
+                                                                                \
+    _batch_direct();                                                            \
+    gfx_device_ops->draw_vline((char *)&pixel, x, y1, y2);                      \
+}                                                                               \
+                                                                                \
+static void _batch_##name##_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y) \
+{                                                                               \
+    rt_uint8_t *ptr;                                                            \
+                                                                                \
+    if (x1 > x2) { int t = x1; x1 = x2; x2 = t; }                               \
+    if (x1 == x2) return;                                                       \
+    ptr = _batch_stage(x1, y, x2 - x1, bpp);                                    \
+    if (ptr == RT_NULL)                                                         \
+        gfx_device_ops->blit_line((char *)pixels, x1, y, x2 - x1);              \
+    else                                                                        \
+        rt_memcpy(ptr, pixels, (x2 - x1) * bpp);                                \
+}                                                                               \
+                                                                                \
+const struct rtgui_graphic_driver_ops _pixel_##name##_ops =                     \
+{                                                                               \
+    _batch_##name##_set_pixel,                                                  \
+    _batch_##name##_get_pixel,                                                  \
+    _batch_##name##_draw_hline,                                                 \
+    _batch_##name##_draw_vline,                                                 \
+    _batch_##name##_draw_raw_hline,                                             \
+};
+
+PIXEL_BATCH_OPS(rgb565, 2, rt_uint16_t, rtgui_color_to_565, rtgui_color_from_565)
+PIXEL_BATCH_OPS(rgb565p, 2, rt_uint16_t, rtgui_color_to_565p, rtgui_color_from_565p)
+PIXEL_BATCH_OPS(rgb888, 3, rt_uint32_t, rtgui_color_to_888, rtgui_color_from_888)
+#else
 static void _pixel_rgb565p_set_pixel(rtgui_color_t *c, int x, int y)
 {
     rt_uint16_t pixel;
@@ -41,14 +228,6 @@ static void _pixel_rgb888_set_pixel(rtgui_color_t *c, int x, int y)
     gfx_device_ops->set_pixel((char *)&pixel, x, y);
 }
 
-static void _pixel_mono_get_pixel(rtgui_color_t *c, int x, int y)
-{
-    rt_uint8_t pixel;
-
-    gfx_device_ops->get_pixel((char *)&pixel, x, y);
-    *c = rtgui_color_from_mono(pixel);
-}
-
 static void _pixel_rgb565p_get_pixel(rtgui_color_t *c, int x, int y)
 {
     rt_uint16_t pixel;
@@ -73,14 +252,6 @@ static void _pixel_rgb888_get_pixel(rtgui_color_t *c, int x, int y)
     *c = rtgui_color_from_888(pixel);
 }
 
-static void _pixel_mono_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
-{
-    rt_uint8_t pixel;
-
-    pixel = rtgui_color_to_mono(*c);
-    gfx_device_ops->draw_hline((char *)&pixel, x1, x2, y);
-}
-
 static void _pixel_rgb565p_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
 {
     rt_uint16_t pixel;
@@ -105,14 +276,6 @@ static void _pixel_rgb888_draw_hline(rtgui_color_t *c, int x1, int x2, int y)
     gfx_device_ops->draw_hline((char *)&pixel, x1, x2, y);
 }
 
-static void _pixel_mono_draw_vline(rtgui_color_t *c, int x, int y1, int y2)
-{
-    rt_uint8_t pixel;
-
-    pixel = rtgui_color_to_mono(*c);
-    gfx_device_ops->draw_vline((char *)&pixel, x, y1, y2);
-}
-
 static void _pixel_rgb565p_draw_vline(rtgui_color_t *c, int x, int y1, int y2)
 {
     rt_uint16_t pixel;
@@ -137,24 +300,6 @@ static void _pixel_rgb888_draw_vline(rtgui_color_t *c, int x, int y1, int y2)
     gfx_device_ops->draw_vline((char *)&pixel, x, y1, y2);
 }
 
-static void _pixel_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y)
-{
-    if (x2 > x1)
-        gfx_device_ops->blit_line((char *)pixels, x1, y, (x2 - x1));
-    else
-        gfx_device_ops->blit_line((char *)pixels, x2, y, (x1 - x2));
-}
-
-/* pixel device */
-const struct rtgui_graphic_driver_ops _pixel_mono_ops =
-{
-    _pixel_mono_set_pixel,
-    _pixel_mono_get_pixel,
-    _pixel_mono_draw_hline,
-    _pixel_mono_draw_vline,
-    _pixel_draw_raw_hline,
-};
-
 const struct rtgui_graphic_driver_ops _pixel_rgb565p_ops =
 {
     _pixel_rgb565p_set_pixel,
@@ -181,6 +326,7 @@ const struct rtgui_graphic_driver_ops _pixel_rgb888_ops =
     _pixel_rgb888_draw_vline,
     _pixel_draw_raw_hline,
 };
+#endif
 
 const struct rtgui_graphic_driver_ops *rtgui_pixel_device_get_ops(int pixel_format)
 {
@@ -36,15 +36,160 @@
 #define PIXREGION_TOP(reg) PIXREGION_BOX(reg, (reg)->data->numRects)
 #define PIXREGION_END(reg) PIXREGION_BOX(reg, (reg)->data->numRects - 1)
 #define PIXREGION_SZOF(n) (sizeof(rtgui_region_data_t) + ((n) * sizeof(rtgui_rect_t)))
+#define PIXREGION_EMPTY(reg) (PIXREGION_NIL(reg) || \
+                              (reg)->extents.x1 >= (reg)->extents.x2 || \
+                              (reg)->extents.y1 >= (reg)->extents.y2)
 
 rtgui_rect_t rtgui_empty_rect = {0, 0, 0, 0};
 rtgui_point_t rtgui_empty_point = {0, 0};
 
-static rtgui_region_data_t rtgui_region_emptydata = {0, 0};
-static rtgui_region_data_t  rtgui_brokendata = {0, 0};
+static rtgui_region_data_t rtgui_region_emptydata = {0, 0, 0};
+static rtgui_region_data_t  rtgui_brokendata = {0, 0, 0};
 
 static rtgui_region_status_t rtgui_break(rtgui_region_t *pReg);
 
+#ifdef RTGUI_USING_REGION_POOL
+#define PIXREGION_BLOCK_SIZE(n) RT_ALIGN(PIXREGION_SZOF(n), RT_ALIGN_SIZE)
+
+static struct rt_mempool rtgui_region_small_pool;
+static struct rt_mempool rtgui_region_large_pool;
+/* each block has a pointer to the pool before it */
+static rt_uint8_t rtgui_region_small_buffer[RTGUI_REGION_POOL_BLOCKS *
+        (PIXREGION_BLOCK_SIZE(RTGUI_REGION_POOL_SMALL) + sizeof(void *))];
+static rt_uint8_t rtgui_region_large_buffer[RTGUI_REGION_POOL_BLOCKS *
+        (PIXREGION_BLOCK_SIZE(RTGUI_REGION_POOL_LARGE) + sizeof(void *))];
+static rt_bool_t rtgui_region_pool_ready = RT_FALSE;
+static struct rtgui_region_pool_stat rtgui_region_pool_stat;
+
+#define PIXREGION_IN_BUFFER(data, buffer) \
+    ((rt_uint8_t *)(data) >= (buffer) && (rt_uint8_t *)(data) < (buffer) + sizeof(buffer))
+
+void rtgui_region_pool_init(void)
+{
+    rt_mp_init(&rtgui_region_small_pool, "grgn_s", rtgui_region_small_buffer,
+               sizeof(rtgui_region_small_buffer), PIXREGION_BLOCK_SIZE(RTGUI_REGION_POOL_SMALL));
+    rt_mp_init(&rtgui_region_large_pool, "grgn_l", rtgui_region_large_buffer,
+               sizeof(rtgui_region_large_buffer), PIXREGION_BLOCK_SIZE(RTGUI_REGION_POOL_LARGE));
+    rtgui_region_pool_ready = RT_TRUE;
+}
+RTM_EXPORT(rtgui_region_pool_init);
+
+/* the rects a block from pool holds, 0 for the one from heap */
+rt_inline int rtgui_data_capacity(rtgui_region_data_t *data)
+{
+    if (PIXREGION_IN_BUFFER(data, rtgui_region_small_buffer))
+        return RTGUI_REGION_POOL_SMALL;
+    if (PIXREGION_IN_BUFFER(data, rtgui_region_large_buffer))
+        return RTGUI_REGION_POOL_LARGE;
+    return 0;
+}
+
+static rtgui_region_data_t *rtgui_data_alloc(int n)
+{
+    rt_base_t level;
+    rtgui_region_data_t *data = RT_NULL;
+
+    if (rtgui_region_pool_ready)
+    {
+        if (n <= RTGUI_REGION_POOL_SMALL)
+            data = rt_mp_alloc(&rtgui_region_small_pool, 0);
+        if (data == RT_NULL && n <= RTGUI_REGION_POOL_LARGE)
+            data = rt_mp_alloc(&rtgui_region_large_pool, 0);
+    }
+
+    level = rt_hw_interrupt_disable();
+    if (data != RT_NULL)
+    {
+        rtgui_region_pool_stat.pooled ++;
+        rtgui_region_pool_stat.used ++;
+    }
+    rt_hw_interrupt_enable(level);
+    if (data != RT_NULL)
+        return data;
+
+    /* too large or the pools are used up */
+    data = rtgui_malloc(PIXREGION_SZOF(n));
+    if (data != RT_NULL)
+    {
+        level = rt_hw_interrupt_disable();
+        rtgui_region_pool_stat.heap ++;
+        rtgui_region_pool_stat.used ++;
+        rt_hw_interrupt_enable(level);
+    }
+
+    return data;
+}
+
+static void rtgui_data_free(rtgui_region_data_t *data)
+{
+    rt_base_t level;
+
+    if (rtgui_data_capacity(data))
+        rt_mp_free(data);
+    else
+        rtgui_free(data);
+
+    level = rt_hw_interrupt_disable();
+    rtgui_region_pool_stat.used --;
+    rt_hw_interrupt_enable(level);
+}
+
+/* the old rects up to data->size are kept like realloc */
+static rtgui_region_data_t *rtgui_data_realloc(rtgui_region_data_t *data, int n)
+{
+    int capacity;
+    rtgui_region_data_t *new_data;
+
+    capacity = rtgui_data_capacity(data);
+    /* the block from pool is large enough */
+    if (n <= capacity)
+        return data;
+
+    if (capacity == 0 && n > RTGUI_REGION_POOL_LARGE)
+    {
+        rt_base_t level;
+
+        /* stay in heap */
+        new_data = rt_realloc(data, PIXREGION_SZOF(n));
+        if (new_data != RT_NULL)
+        {
+            level = rt_hw_interrupt_disable();
+            rtgui_region_pool_stat.heap ++;
+            rt_hw_interrupt_enable(level);
+        }
+        return new_data;
+    }
+
+    new_data = rtgui_data_alloc(n);
+    if (new_data == RT_NULL)
+        return RT_NULL;
+
+    rt_memcpy(new_data, data, PIXREGION_SZOF(RTGUI_MIN((int)data->size, n)));
+    rtgui_data_free(data);
+
+    return new_data;
+}
+
+void rtgui_region_get_pool_stat(struct rtgui_region_pool_stat *stat)
+{
+    RT_ASSERT(stat != RT_NULL);
+
+    *stat = rtgui_region_pool_stat;
+}
+RTM_EXPORT(rtgui_region_get_pool_stat);
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+void list_region_pool(void)
+{
+    rt_kprintf("region rects: %d from pool, %d from heap, %d in use\n",
+               rtgui_region_pool_stat.pooled, rtgui_region_pool_stat.heap,
+               rtgui_region_pool_stat.used);
+}
+FINSH_FUNCTION_EXPORT(list_region_pool, display region rects pool statistics);
+#endif
+#endif
+
 /*
  * The functions in this file implement the Region abstraction used extensively
  * throughout the X11 sample server. A Region is simply a set of disjoint
@@ -120,8 +265,21 @@ static rtgui_region_status_t rtgui_break(rtgui_region_t *pReg);
         ((r1)->y1 >= (r2)->y1) && \
         ((r1)->y2 <= (r2)->y2) )
 
+#ifdef RTGUI_USING_REGION_POOL
+static rtgui_region_data_t *rtgui_data_alloc(int n);
+static rtgui_region_data_t *rtgui_data_realloc(rtgui_region_data_t *data, int n);
+static void rtgui_data_free(rtgui_region_data_t *data);
+
+#define allocData(n) rtgui_data_alloc(n)
+#define reallocData(data, n) rtgui_data_realloc(data, n)
+#define freeData(reg) if ((reg)->data && (reg)->data->size) rtgui_data_free((reg)->data)
+#define freeOldData(data) rtgui_data_free(data)
+#else
 #define allocData(n) rtgui_malloc(PIXREGION_SZOF(n))
+#define reallocData(data, n) rt_realloc(data, PIXREGION_SZOF(n))
 #define freeData(reg) if ((reg)->data && (reg)->data->size) rtgui_free((reg)->data)
+#define freeOldData(data) rtgui_free(data)
+#endif
 
 #define RECTALLOC_BAIL(pReg,n,bail) \
 if (!(pReg)->data || (((pReg)->data->numRects + (n)) > (pReg)->data->size)) \
@@ -157,7 +315,7 @@ if (!(pReg)->data || (((pReg)->data->numRects + (n)) > (pReg)->data->size)) \
 if (((numRects) < ((reg)->data->size >> 1)) && ((reg)->data->size > 50)) \
 {                                    \
     rtgui_region_data_t * NewData;                           \
-    NewData = (rtgui_region_data_t *)rt_realloc((reg)->data, PIXREGION_SZOF(numRects));  \
+    NewData = (rtgui_region_data_t *)reallocData((reg)->data, numRects);  \
     if (NewData)                             \
     {                                    \
     NewData->size = (numRects);                  \
@@ -221,6 +379,7 @@ static rtgui_region_status_t rtgui_rect_alloc(rtgui_region_t *region, int n)
         region->data = allocData(n);
         if (!region->data) return rtgui_break(region);
         region->data->numRects = 1;
+        region->data->hit = 0;
         *PIXREGION_BOXPTR(region) = region->extents;
     }
     else if (!region->data->size)
@@ -228,6 +387,7 @@ static rtgui_region_status_t rtgui_rect_alloc(rtgui_region_t *region, int n)
         region->data = allocData(n);
         if (!region->data) return rtgui_break(region);
         region->data->numRects = 0;
+        region->data->hit = 0;
     }
     else
     {
@@ -238,7 +398,7 @@ static rtgui_region_status_t rtgui_rect_alloc(rtgui_region_t *region, int n)
                 n = 250;
         }
         n += region->data->numRects;
-        data = (rtgui_region_data_t *)rt_realloc(region->data, PIXREGION_SZOF(n));
+        data = (rtgui_region_data_t *)reallocData(region->data, n);
         if (!data) return rtgui_break(region);
         region->data = data;
     }
@@ -265,6 +425,7 @@ rtgui_region_status_t rtgui_region_copy(rtgui_region_t *dst, rtgui_region_t *src
         dst->data = allocData(src->data->numRects);
         if (!dst->data) return rtgui_break(dst);
         dst->data->size = src->data->numRects;
+        dst->data->hit = 0;
     }
     dst->data->numRects = src->data->numRects;
     rt_memmove((char *)PIXREGION_BOXPTR(dst), (char *)PIXREGION_BOXPTR(src),
@@ -686,7 +847,7 @@ rtgui_op(
     }
 
     if (oldData)
-        rtgui_free(oldData);
+        freeOldData(oldData);
 
     numRects = newReg->data->numRects;
     if (!numRects)
@@ -1751,6 +1912,47 @@ rtgui_region_inverse(rtgui_region_t *newReg,       /* Destination region */
     return RTGUI_REGION_STATUS_SUCCESS;
 }
 
+/* the regions with more boxes are searched by bisection */
+#define PIXREGION_BSEARCH_MIN   8
+
+/*
+ * The boxes are y-x banded, so y2 never decreases from box to box and the
+ * bands are found by bisection on y2, the boxes in a band by x2.
+ */
+
+/* the first box below y, or pboxEnd */
+rt_inline rtgui_rect_t *rtgui_find_band(rtgui_rect_t *pbox, rtgui_rect_t *pboxEnd, int y)
+{
+    rtgui_rect_t *pmid;
+
+    while (pbox != pboxEnd)
+    {
+        pmid = pbox + (pboxEnd - pbox) / 2;
+        if (pmid->y2 <= y)
+            pbox = pmid + 1;
+        else
+            pboxEnd = pmid;
+    }
+    return pbox;
+}
+
+/* the first box of the band at pbox not left of x, or the next band */
+rt_inline rtgui_rect_t *rtgui_find_in_band(rtgui_rect_t *pbox, rtgui_rect_t *pboxEnd, int x)
+{
+    int y1 = pbox->y1;
+    rtgui_rect_t *pmid;
+
+    while (pbox != pboxEnd)
+    {
+        pmid = pbox + (pboxEnd - pbox) / 2;
+        if (pmid->y1 == y1 && pmid->x2 <= x)
+            pbox = pmid + 1;
+        else
+            pboxEnd = pmid;
+    }
+    return pbox;
+}
+
 /*
  *   RectIn(region, rect)
  *   This routine takes a pointer to a region and a pointer to a box
@@ -1799,10 +2001,14 @@ int rtgui_region_contains_rectangle(rtgui_region_t *region, rtgui_rect_t *prect)
     x = prect->x1;
     y = prect->y1;
 
+    pbox = PIXREGION_BOXPTR(region);
+    pboxEnd = pbox + numRects;
+    /* skip the bands above the rectangle */
+    if (numRects >= PIXREGION_BSEARCH_MIN)
+        pbox = rtgui_find_band(pbox, pboxEnd, y);
+
     /* can stop when both partOut and partIn are RTGUI_REGION_STATUS_SUCCESS, or we reach prect->y2 */
-    for (pbox = PIXREGION_BOXPTR(region), pboxEnd = pbox + numRects;
-            pbox != pboxEnd;
-            pbox++)
+    for (; pbox != pboxEnd; pbox++)
     {
 
         if (pbox->y2 <= y)
@@ -1969,9 +2175,31 @@ int rtgui_region_contains_point(rtgui_region_t *region,
         return RT_EOK;
     }
 
-    for (pbox = PIXREGION_BOXPTR(region), pboxEnd = pbox + numRects;
-            pbox != pboxEnd;
-            pbox++)
+    /* the points drawn are mostly next to the last one */
+    pbox = PIXREGION_BOXPTR(region);
+    if (region->data->hit < (rt_uint32_t)numRects &&
+            INBOX(&pbox[region->data->hit], x, y))
+    {
+        *box = pbox[region->data->hit];
+        return RT_EOK;
+    }
+
+    pboxEnd = pbox + numRects;
+    if (numRects >= PIXREGION_BSEARCH_MIN)
+    {
+        pbox = rtgui_find_band(pbox, pboxEnd, y);
+        if (pbox == pboxEnd || y < pbox->y1)
+            return -RT_ERROR;
+        pbox = rtgui_find_in_band(pbox, pboxEnd, x);
+        if (pbox == pboxEnd || !INBOX(pbox, x, y))
+            return -RT_ERROR;
+
+        region->data->hit = pbox - PIXREGION_BOXPTR(region);
+        *box = *pbox;
+        return RT_EOK;
+    }
+
+    for (; pbox != pboxEnd; pbox++)
     {
         if (y >= pbox->y2)
             continue;       /* not there yet */
@@ -1979,6 +2207,7 @@ int rtgui_region_contains_point(rtgui_region_t *region,
             break;      /* missed it */
         if (x >= pbox->x2)
             continue;       /* not there yet */
+        region->data->hit = pbox - PIXREGION_BOXPTR(region);
         *box = *pbox;
         return RT_EOK;
     }
@@ -2136,6 +2365,32 @@ void rtgui_region_dump(rtgui_region_t *region)
 }
 
 
+/* return RT_EOK if the two regions cover the same area */
+int rtgui_region_is_equal(rtgui_region_t *reg1, rtgui_region_t *reg2)
+{
+    int num;
+
+    good(reg1);
+    good(reg2);
+
+    /* the empty regions may have different extents */
+    if (PIXREGION_EMPTY(reg1) || PIXREGION_EMPTY(reg2))
+        return (PIXREGION_EMPTY(reg1) && PIXREGION_EMPTY(reg2)) ? RT_EOK : -RT_ERROR;
+
+    /* the bands of region are unique for an area */
+    num = PIXREGION_NUM_RECTS(reg1);
+    if (num != PIXREGION_NUM_RECTS(reg2) ||
+        rtgui_rect_is_equal(&reg1->extents, &reg2->extents) != RT_EOK)
+        return -RT_ERROR;
+
+    if (num > 1 && rt_memcmp(PIXREGION_RECTS(reg1), PIXREGION_RECTS(reg2),
+                             num * sizeof(rtgui_rect_t)) != 0)
+        return -RT_ERROR;
+
+    return RT_EOK;
+}
+RTM_EXPORT(rtgui_region_is_equal);
+
 int rtgui_region_is_flat(rtgui_region_t *region)
 {
     int num;
@@ -30,9 +30,38 @@ static void _rtgui_app_constructor(struct rtgui_app *app)
     app->ref_count      = 0;
     app->exit_code      = 0;
     app->tid            = RT_NULL;
+#ifdef RTGUI_USING_EVENT_RING
+    app->ring.slots     = RT_NULL;
+#else
     app->mq             = RT_NULL;
+#endif
     app->main_object    = RT_NULL;
     app->on_idle        = RT_NULL;
+#ifdef RTGUI_USING_COMPOSITOR
+    app->surface        = RT_NULL;
+#endif
+#ifdef RTGUI_USING_DEFERRED_PAINT
+    app->dirty_wins     = RT_NULL;
+#endif
+#ifdef RTGUI_USING_ID_HASH
+    app->id_buckets     = RT_NULL;
+    app->id_bits        = 0;
+    app->id_count       = 0;
+#endif
+#ifdef RTGUI_USING_ASYNC_ACK
+    {
+        int index;
+
+        for (index = 0; index < RTGUI_APP_ACK_NUM; index ++)
+        {
+            rt_mb_init(&app->acks[index].mb, "ack", &app->acks[index].buffer, 1, 0);
+            app->acks[index].busy = RT_FALSE;
+        }
+    }
+#endif
+#ifdef RTGUI_USING_EVENT_LANES
+    rt_memset(app->lanes, 0, sizeof(app->lanes));
+#endif
 }
 
 static void _rtgui_app_destructor(struct rtgui_app *app)
@@ -41,6 +70,37 @@ static void _rtgui_app_destructor(struct rtgui_app *app)
 
     rt_free(app->name);
     app->name = RT_NULL;
+
+#ifdef RTGUI_USING_ID_HASH
+    /* the objects left in table may be destroyed or get an ID later */
+    if (app->id_buckets != RT_NULL)
+    {
+        rt_uint32_t index;
+        struct rtgui_object *object, *next;
+
+        for (index = 0; index < (1UL << app->id_bits); index ++)
+        {
+            for (object = app->id_buckets[index]; object != RT_NULL; object = next)
+            {
+                next = object->id_next;
+                object->id_app = RT_NULL;
+                object->id_next = RT_NULL;
+            }
+        }
+        rtgui_free(app->id_buckets);
+        app->id_buckets = RT_NULL;
+        app->id_count = 0;
+    }
+#endif
+
+#ifdef RTGUI_USING_ASYNC_ACK
+    {
+        int index;
+
+        for (index = 0; index < RTGUI_APP_ACK_NUM; index ++)
+            rt_mb_detach(&app->acks[index].mb);
+    }
+#endif
 }
 
 DEFINE_CLASS_TYPE(application, "application",
@@ -70,12 +130,20 @@ struct rtgui_app *rtgui_app_create(const char *title)
     app->tid = tid;
 
     rt_snprintf(mq_name, RT_NAME_MAX, "g%s", title);
+#ifdef RTGUI_USING_EVENT_RING
+    if (rtgui_event_ring_init(&app->ring, mq_name, RTGUI_EVENT_RING_SIZE) != RT_EOK)
+    {
+        rt_kprintf("create event ring failed.\n");
+        goto __mq_err;
+    }
+#else
     app->mq = rt_mq_create(mq_name, sizeof(union rtgui_event_generic), 32, RT_IPC_FLAG_FIFO);
     if (app->mq == RT_NULL)
     {
         rt_kprintf("create msgq failed.\n");
         goto __mq_err;
     }
+#endif
 
     /* set application title */
     app->name = (unsigned char *)rt_strdup((char *)title);
@@ -103,18 +171,29 @@ struct rtgui_app *rtgui_app_create(const char *title)
     }
 
 __err:
+#ifdef RTGUI_USING_EVENT_RING
+    rtgui_event_ring_fini(&app->ring);
+#else
+    rt_mq_delete(app->mq);
+#endif
 __mq_err:
     rtgui_object_destroy(RTGUI_OBJECT(app));
     return RT_NULL;
 }
 RTM_EXPORT(rtgui_app_create);
 
+#ifdef RTGUI_USING_EVENT_RING
+#define _rtgui_application_check_queue(app)     RT_ASSERT(app->ring.slots != RT_NULL)
+#else
+#define _rtgui_application_check_queue(app)     RT_ASSERT(app->mq != RT_NULL)
+#endif
+
 #define _rtgui_application_check(app)           \
     do {                                        \
         RT_ASSERT(app != RT_NULL);              \
         RT_ASSERT(app->tid != RT_NULL);         \
         RT_ASSERT(app->tid->user_data != 0);    \
-        RT_ASSERT(app->mq != RT_NULL);          \
+        _rtgui_application_check_queue(app);    \
     } while (0)
 
 void rtgui_app_destroy(struct rtgui_app *app)
@@ -145,7 +224,11 @@ void rtgui_app_destroy(struct rtgui_app *app)
     }
 
     app->tid->user_data = 0;
+#ifdef RTGUI_USING_EVENT_RING
+    rtgui_event_ring_fini(&app->ring);
+#else
     rt_mq_delete(app->mq);
+#endif
     rtgui_object_destroy(RTGUI_OBJECT(app));
 }
 RTM_EXPORT(rtgui_app_destroy);
@@ -305,6 +388,390 @@ rt_bool_t rtgui_app_event_handler(struct rtgui_object *object, rtgui_event_t *ev
 }
 RTM_EXPORT(rtgui_app_event_handler);
 
+/* handle the event, or the event a pooled event points to */
+rt_inline void _rtgui_application_dispatch(struct rtgui_app *app, struct rtgui_event *event)
+{
+#ifdef RTGUI_USING_EVENT_POOL
+    if (event->type == RTGUI_EVENT_POOLED)
+    {
+        struct rtgui_event *pooled = ((struct rtgui_event_pooled *)event)->event;
+
+        RTGUI_OBJECT(app)->event_handler(RTGUI_OBJECT(app), pooled);
+        rtgui_event_release(pooled);
+        return;
+    }
+#endif
+
+    RTGUI_OBJECT(app)->event_handler(RTGUI_OBJECT(app), event);
+}
+
+#ifdef RTGUI_USING_EVENT_LANES
+static enum rtgui_app_lane_type _rtgui_application_lane_of(struct rtgui_event *event)
+{
+#ifdef RTGUI_USING_EVENT_POOL
+    if (event->type == RTGUI_EVENT_POOLED)
+        event = ((struct rtgui_event_pooled *)event)->event;
+#endif
+
+    switch (event->type)
+    {
+    case RTGUI_EVENT_MOUSE_MOTION:
+    case RTGUI_EVENT_MOUSE_BUTTON:
+    case RTGUI_EVENT_KBD:
+    case RTGUI_EVENT_TOUCH:
+    case RTGUI_EVENT_GESTURE:
+        return RTGUI_APP_LANE_INPUT;
+
+    case RTGUI_EVENT_APP_CREATE:
+    case RTGUI_EVENT_APP_DESTROY:
+    case RTGUI_EVENT_APP_ACTIVATE:
+    case RTGUI_EVENT_WIN_CREATE:
+    case RTGUI_EVENT_WIN_DESTROY:
+    case RTGUI_EVENT_WIN_SHOW:
+    case RTGUI_EVENT_WIN_HIDE:
+    case RTGUI_EVENT_WIN_ACTIVATE:
+    case RTGUI_EVENT_WIN_DEACTIVATE:
+    case RTGUI_EVENT_WIN_CLOSE:
+    case RTGUI_EVENT_WIN_MOVE:
+    case RTGUI_EVENT_WIN_RESIZE:
+    case RTGUI_EVENT_WIN_MODAL_ENTER:
+    case RTGUI_EVENT_SET_WM:
+    case RTGUI_EVENT_MONITOR_ADD:
+    case RTGUI_EVENT_MONITOR_REMOVE:
+    case RTGUI_EVENT_SHOW:
+    case RTGUI_EVENT_HIDE:
+    case RTGUI_EVENT_UPDATE_TOPLVL:
+    case RTGUI_EVENT_VPAINT_REQ:
+    case RTGUI_EVENT_VPAINT_ACK:
+    case RTGUI_EVENT_CLIP_INFO:
+    case RTGUI_EVENT_FOCUSED:
+    case RTGUI_EVENT_RESIZE:
+        return RTGUI_APP_LANE_WINDOW;
+
+    case RTGUI_EVENT_PAINT:
+    case RTGUI_EVENT_UPDATE_BEGIN:
+    case RTGUI_EVENT_UPDATE_END:
+        return RTGUI_APP_LANE_PAINT;
+
+    default:
+        return RTGUI_APP_LANE_OTHER;
+    }
+}
+
+static void _rtgui_application_lane_push(struct rtgui_app *app,
+                                         enum rtgui_app_lane_type type,
+                                         struct rtgui_event *event)
+{
+    rt_uint16_t index;
+    struct rtgui_app_lane *lane = &app->lanes[type];
+
+    RT_ASSERT(lane->stat.depth < RTGUI_APP_LANE_DEPTH);
+
+    index = (lane->first + lane->stat.depth) % RTGUI_APP_LANE_DEPTH;
+    rt_memcpy(&lane->events[index], event, sizeof(union rtgui_event_generic));
+    lane->ticks[index] = rt_tick_get();
+
+    lane->stat.depth ++;
+    if (lane->stat.depth > lane->stat.max_depth)
+        lane->stat.max_depth = lane->stat.depth;
+}
+
+/* take the first event out of lane */
+static void _rtgui_application_lane_shift(struct rtgui_app *app,
+                                          enum rtgui_app_lane_type type,
+                                          struct rtgui_event *event)
+{
+    rt_tick_t wait;
+    struct rtgui_app_lane *lane = &app->lanes[type];
+
+    RT_ASSERT(lane->stat.depth != 0);
+
+    rt_memcpy(event, &lane->events[lane->first], sizeof(union rtgui_event_generic));
+
+    wait = rt_tick_get() - lane->ticks[lane->first];
+    lane->stat.handled ++;
+    lane->stat.total_wait += wait;
+    if (wait > lane->stat.max_wait)
+        lane->stat.max_wait = wait;
+
+    lane->first = (lane->first + 1) % RTGUI_APP_LANE_DEPTH;
+    lane->stat.depth --;
+}
+
+/* whether any lane is full */
+static rt_bool_t _rtgui_application_lane_full(struct rtgui_app *app)
+{
+    int type;
+
+    for (type = 0; type < RTGUI_APP_LANE_MAX; type ++)
+    {
+        if (app->lanes[type].stat.depth == RTGUI_APP_LANE_DEPTH)
+            return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+/* pull the events in queue into lanes until queue is empty. The queue can not
+ * be peeked, so stop while any lane is full and leave the rest in queue until
+ * lane_pop makes room */
+static void _rtgui_application_lane_pull(struct rtgui_app *app)
+{
+    union rtgui_event_generic event;
+
+    while (_rtgui_application_lane_full(app) == RT_FALSE &&
+           rtgui_recv_nosuspend(&event.base, sizeof(event)) == RT_EOK)
+    {
+        _rtgui_application_lane_push(app, _rtgui_application_lane_of(&event.base),
+                                     &event.base);
+    }
+}
+
+/* pop the event of the highest lane, or the one waited too long */
+static rt_err_t _rtgui_application_lane_pop(struct rtgui_app *app, struct rtgui_event *event)
+{
+    int type, selected = -1;
+    rt_tick_t now, wait, max_wait = 0;
+    struct rtgui_app_lane *lane;
+
+    now = rt_tick_get();
+    for (type = 0; type < RTGUI_APP_LANE_MAX; type ++)
+    {
+        lane = &app->lanes[type];
+        if (lane->stat.depth == 0)
+            continue;
+
+        if (selected == -1)
+            selected = type;
+
+        wait = now - lane->ticks[lane->first];
+        if (wait >= RTGUI_APP_LANE_MAX_WAIT && wait > max_wait)
+        {
+            /* the lower lane is starved */
+            selected = type;
+            max_wait = wait;
+        }
+    }
+    if (selected == -1)
+        return -RT_EEMPTY;
+
+    _rtgui_application_lane_shift(app, (enum rtgui_app_lane_type)selected, event);
+
+    return RT_EOK;
+}
+
+/* take the first event of type out of lanes, for rtgui_recv_filter. The
+ * events still in queue are left to the filter */
+rt_err_t rtgui_app_lane_take(struct rtgui_app *app, rt_uint32_t type,
+                             struct rtgui_event *event, rt_size_t event_size)
+{
+    int lane_type;
+    rt_uint16_t count, slot, next;
+    struct rtgui_event *found;
+    struct rtgui_app_lane *lane;
+
+    for (lane_type = 0; lane_type < RTGUI_APP_LANE_MAX; lane_type ++)
+    {
+        lane = &app->lanes[lane_type];
+        for (count = 0; count < lane->stat.depth; count ++)
+        {
+            slot = (lane->first + count) % RTGUI_APP_LANE_DEPTH;
+            found = &(lane->events[slot].base);
+#ifdef RTGUI_USING_EVENT_POOL
+            if (found->type == RTGUI_EVENT_POOLED)
+            {
+                struct rtgui_event *pooled = ((struct rtgui_event_pooled *)found)->event;
+
+                if (pooled->type != type)
+                    continue;
+                rt_memcpy(event, pooled, _UI_MIN(event_size, rtgui_event_get_size(pooled)));
+                rtgui_event_release(pooled);
+            }
+            else
+#endif
+            {
+                if (found->type != type)
+                    continue;
+                rt_memcpy(event, found, event_size);
+            }
+            lane->stat.handled ++;
+
+            /* move the later events forward to close the gap */
+            for (count ++; count < lane->stat.depth; count ++)
+            {
+                next = (lane->first + count) % RTGUI_APP_LANE_DEPTH;
+                lane->events[slot] = lane->events[next];
+                lane->ticks[slot] = lane->ticks[next];
+                slot = next;
+            }
+            lane->stat.depth --;
+
+            return RT_EOK;
+        }
+    }
+
+    return -RT_EEMPTY;
+}
+
+void rtgui_app_get_lane_stat(struct rtgui_app *app, enum rtgui_app_lane_type lane,
+                             struct rtgui_app_lane_stat *stat)
+{
+    RT_ASSERT(app != RT_NULL);
+    RT_ASSERT(lane < RTGUI_APP_LANE_MAX);
+    RT_ASSERT(stat != RT_NULL);
+
+    *stat = app->lanes[lane].stat;
+}
+RTM_EXPORT(rtgui_app_get_lane_stat);
+#endif
+
+#ifdef RTGUI_USING_ID_HASH
+#define RTGUI_APP_ID_BITS_MIN   4
+/* Fibonacci hashing, the IDs are often small numbers or aligned addresses */
+#define _rtgui_app_id_hash(id, bits) \
+    ((rt_uint32_t)((rt_uint32_t)(id) * 2654435761UL) >> (32 - (bits)))
+
+/* rehash the table into twice the buckets, keep the old one if no memory */
+static void _rtgui_app_id_grow(struct rtgui_app *app)
+{
+    rt_uint32_t index, hash;
+    rt_uint8_t bits;
+    struct rtgui_object **buckets;
+    struct rtgui_object *object, *next;
+
+    bits = app->id_buckets == RT_NULL ? RTGUI_APP_ID_BITS_MIN : app->id_bits + 1;
+    buckets = rtgui_malloc(sizeof(struct rtgui_object *) << bits);
+    if (buckets == RT_NULL)
+        return;
+    rt_memset(buckets, 0, sizeof(struct rtgui_object *) << bits);
+
+    if (app->id_buckets != RT_NULL)
+    {
+        for (index = 0; index < (1UL << app->id_bits); index ++)
+        {
+            for (object = app->id_buckets[index]; object != RT_NULL; object = next)
+            {
+                next = object->id_next;
+                hash = _rtgui_app_id_hash(object->id, bits);
+                object->id_next = buckets[hash];
+                buckets[hash] = object;
+            }
+        }
+        rtgui_free(app->id_buckets);
+    }
+
+    app->id_buckets = buckets;
+    app->id_bits = bits;
+}
+
+void rtgui_app_id_add(struct rtgui_app *app, struct rtgui_object *object)
+{
+    rt_uint32_t hash;
+
+    RT_ASSERT(object != RT_NULL);
+    RT_ASSERT(object->id_app == RT_NULL);
+
+    if (app == RT_NULL)
+        return;
+
+    /* keep 2 objects a bucket at most */
+    if (app->id_buckets == RT_NULL || app->id_count >= (2UL << app->id_bits))
+        _rtgui_app_id_grow(app);
+    /* not hashed, it's still found by walking the windows */
+    if (app->id_buckets == RT_NULL)
+        return;
+
+    hash = _rtgui_app_id_hash(object->id, app->id_bits);
+    object->id_next = app->id_buckets[hash];
+    app->id_buckets[hash] = object;
+    object->id_app = app;
+    app->id_count ++;
+}
+RTM_EXPORT(rtgui_app_id_add);
+
+void rtgui_app_id_remove(struct rtgui_object *object)
+{
+    struct rtgui_app *app;
+    struct rtgui_object **link;
+
+    RT_ASSERT(object != RT_NULL);
+
+    /* it may be destroyed in another thread than the owner */
+    app = object->id_app;
+    if (app == RT_NULL)
+        return;
+    RT_ASSERT(app->id_buckets != RT_NULL);
+
+    link = &app->id_buckets[_rtgui_app_id_hash(object->id, app->id_bits)];
+    for (; *link != RT_NULL; link = &(*link)->id_next)
+    {
+        if (*link == object)
+        {
+            *link = object->id_next;
+            object->id_next = RT_NULL;
+            object->id_app = RT_NULL;
+            app->id_count --;
+            break;
+        }
+    }
+}
+RTM_EXPORT(rtgui_app_id_remove);
+
+struct rtgui_object *rtgui_app_id_find(struct rtgui_app *app, rt_uint32_t id)
+{
+    struct rtgui_object *object;
+
+    if (app == RT_NULL || app->id_buckets == RT_NULL)
+        return RT_NULL;
+
+    object = app->id_buckets[_rtgui_app_id_hash(id, app->id_bits)];
+    for (; object != RT_NULL; object = object->id_next)
+    {
+        if (object->id == id)
+            return object;
+    }
+
+    return RT_NULL;
+}
+RTM_EXPORT(rtgui_app_id_find);
+#endif
+
+#ifdef RTGUI_USING_DEFERRED_PAINT
+void rtgui_app_paint_dirty(struct rtgui_app *app)
+{
+    struct rtgui_win *win, *next;
+
+    _rtgui_application_check(app);
+
+    /* the windows invalidated in painting are linked again */
+    win = app->dirty_wins;
+    app->dirty_wins = RT_NULL;
+    for (; win != RT_NULL; win = next)
+    {
+        next = win->dirty_next;
+        win->dirty_next = RT_NULL;
+        rtgui_win_paint_dirty(win);
+    }
+}
+RTM_EXPORT(rtgui_app_paint_dirty);
+
+#define _rtgui_application_has_idle(app)    \
+    ((app)->on_idle != RT_NULL || (app)->dirty_wins != RT_NULL)
+#else
+#define _rtgui_application_has_idle(app)    ((app)->on_idle != RT_NULL)
+#endif
+
+/* no event in queue, paint the invalidated widgets and run idle handler */
+rt_inline void _rtgui_application_idle(struct rtgui_app *app)
+{
+#ifdef RTGUI_USING_DEFERRED_PAINT
+    if (app->dirty_wins != RT_NULL)
+        rtgui_app_paint_dirty(app);
+#endif
+    if (app->on_idle != RT_NULL)
+        app->on_idle(RTGUI_OBJECT(app), RT_NULL);
+}
+
 rt_inline void _rtgui_application_event_loop(struct rtgui_app *app)
 {
     rt_err_t result;
@@ -322,20 +789,46 @@ rt_inline void _rtgui_application_event_loop(struct rtgui_app *app)
     {
         RT_ASSERT(current_ref == app->ref_count);
 
-        if (app->on_idle != RT_NULL)
+#ifdef RTGUI_USING_DEFERRED_PAINT
+        /* the event queue is busy for a whole frame, paint now */
+        if (app->dirty_wins != RT_NULL &&
+            rt_tick_get() - app->dirty_tick >= RTGUI_UPDATE_FRAME_TICKS)
+            rtgui_app_paint_dirty(app);
+#endif
+
+#ifdef RTGUI_USING_EVENT_LANES
+        _rtgui_application_lane_pull(app);
+        if (_rtgui_application_lane_pop(app, event) == RT_EOK)
+        {
+            _rtgui_application_dispatch(app, event);
+        }
+        else if (_rtgui_application_has_idle(app))
+        {
+            _rtgui_application_idle(app);
+        }
+        else
+        {
+            /* all lanes are empty, wait for the next event */
+            result = rtgui_recv(event, sizeof(union rtgui_event_generic));
+            if (result == RT_EOK)
+                _rtgui_application_lane_push(app, _rtgui_application_lane_of(event), event);
+        }
+#else
+        if (_rtgui_application_has_idle(app))
         {
             result = rtgui_recv_nosuspend(event, sizeof(union rtgui_event_generic));
             if (result == RT_EOK)
-                RTGUI_OBJECT(app)->event_handler(RTGUI_OBJECT(app), event);
+                _rtgui_application_dispatch(app, event);
             else if (result == -RT_ETIMEOUT)
-                app->on_idle(RTGUI_OBJECT(app), RT_NULL);
+                _rtgui_application_idle(app);
         }
         else
         {
             result = rtgui_recv(event, sizeof(union rtgui_event_generic));
             if (result == RT_EOK)
-                RTGUI_OBJECT(app)->event_handler(RTGUI_OBJECT(app), event);
+                _rtgui_application_dispatch(app, event);
         }
+#endif
     }
 }
 
@@ -14,6 +14,9 @@
 
 #include <rtgui/rtgui_object.h>
 #include <rtgui/rtgui_system.h>
+#ifdef RTGUI_USING_ID_HASH
+#include <rtgui/rtgui_app.h>
+#endif
 
 static void _rtgui_object_constructor(rtgui_object_t *object)
 {
@@ -22,6 +25,10 @@ static void _rtgui_object_constructor(rtgui_object_t *object)
 
     object->flag = RTGUI_OBJECT_FLAG_VALID;
     object->id   = (rt_uint32_t)object;
+#ifdef RTGUI_USING_ID_HASH
+    object->id_app  = RT_NULL;
+    object->id_next = RT_NULL;
+#endif
 }
 
 /* Destroys the object */
@@ -30,6 +37,10 @@ static void _rtgui_object_destructor(rtgui_object_t *object)
     /* Any valid objest should both have valid flag _and_ valid type. Only use
      * flag is not enough because the chunk of memory may be reallocted to other
      * object and thus the flag will become valid. */
+#ifdef RTGUI_USING_ID_HASH
+    if (object->id_app != RT_NULL)
+        rtgui_app_id_remove(object);
+#endif
     object->flag = RTGUI_OBJECT_FLAG_NONE;
     object->type = RT_NULL;
 }
@@ -61,10 +72,65 @@ void rtgui_type_destructors_call(const rtgui_type_t *type, rtgui_object_t *objec
         rtgui_type_destructors_call(type->parent, object);
 }
 
+#ifdef RTGUI_USING_TYPE_ANCESTORS
+#define RTGUI_TYPE_TOO_DEEP     0xFF
+
+/* the depth of type, 0 if the type has to walk the parents */
+static rt_uint8_t _rtgui_type_depth(const rtgui_type_t *type)
+{
+    rt_base_t level;
+    rt_uint8_t depth;
+    const rtgui_type_t *t;
+    struct rtgui_type_info *info = type->info;
+
+    if (info == RT_NULL)
+        return 0;
+    if (info->depth != 0)
+        return info->depth == RTGUI_TYPE_TOO_DEEP ? 0 : info->depth;
+
+    depth = 0;
+    for (t = type; t != RT_NULL; t = t->parent)
+        depth ++;
+
+    /* the checks in other threads see the depth after the ancestors */
+    level = rt_hw_interrupt_disable();
+    if (depth > RTGUI_TYPE_DEPTH_MAX)
+    {
+        info->depth = RTGUI_TYPE_TOO_DEEP;
+        depth = 0;
+    }
+    else
+    {
+        rt_uint8_t index = depth;
+
+        for (t = type; t != RT_NULL; t = t->parent)
+            info->ancestors[-- index] = t;
+        info->depth = depth;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return depth;
+}
+#endif
+
 rt_bool_t rtgui_type_inherits_from(const rtgui_type_t *type, const rtgui_type_t *parent)
 {
     const rtgui_type_t *t;
 
+#ifdef RTGUI_USING_TYPE_ANCESTORS
+    if (type != RT_NULL && parent != RT_NULL)
+    {
+        rt_uint8_t depth, parent_depth;
+
+        depth = _rtgui_type_depth(type);
+        parent_depth = _rtgui_type_depth(parent);
+        /* the parent is the ancestor of same depth */
+        if (depth != 0 && parent_depth != 0)
+            return parent_depth <= depth &&
+                   type->info->ancestors[parent_depth - 1] == parent;
+    }
+#endif
+
     t = type;
     while (t)
     {
@@ -211,12 +277,25 @@ RTM_EXPORT(rtgui_object_event_handler);
 
 void rtgui_object_set_id(struct rtgui_object *object, rt_uint32_t id)
 {
+#ifdef RTGUI_USING_ID_HASH
+    struct rtgui_app *app = rtgui_app_self();
+
+#ifdef RTGUI_USING_ID_CHECK
+    /* the IDs set before are all in table */
+    RT_ASSERT(rtgui_app_id_find(app, id) == RT_NULL);
+#endif
+
+    rtgui_app_id_remove(object);
+    object->id = id;
+    rtgui_app_id_add(app, object);
+#else
 #ifdef RTGUI_USING_ID_CHECK
     struct rtgui_object *obj = rtgui_get_self_object(id);
     RT_ASSERT(!obj);
 #endif
 
     object->id = id;
+#endif
 }
 RTM_EXPORT(rtgui_object_set_id);
 
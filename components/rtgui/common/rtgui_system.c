@@ -14,6 +14,7 @@
 
 #include <rtgui/rtgui.h>
 #include <rtgui/image.h>
+#include <rtgui/blit.h>
 #include <rtgui/font.h>
 #include <rtgui/event.h>
 #include <rtgui/rtgui_app.h>
@@ -29,10 +30,22 @@
 static rtgui_rect_t _mainwin_rect;
 static struct rt_mutex _screen_lock;
 
+#ifdef RTGUI_USING_EVENT_POOL
+static void rtgui_event_pool_init(void);
+#endif
+
 int rtgui_system_server_init(void)
 {
     rt_mutex_init(&_screen_lock, "screen", RT_IPC_FLAG_FIFO);
+#ifdef RTGUI_USING_EVENT_POOL
+    rtgui_event_pool_init();
+#endif
+#ifdef RTGUI_USING_REGION_POOL
+    rtgui_region_pool_init();
+#endif
 
+    /* init pixel format converters */
+    rtgui_blit_line_init();
     /* init image */
     rtgui_system_image_init();
     /* init font */
@@ -380,6 +393,7 @@ const char *rtgui_event_string[] =
     "SELECTED",             /* widget selected      */
     "UNSELECTED",           /* widget unselected    */
     "MV_MODEL",             /* modal chaned in MV   */
+    "POOLED",               /* pooled event         */
 };
 
 #define DBG_MSG(x)  rt_kprintf x
@@ -560,6 +574,23 @@ static void rtgui_event_dump(struct rtgui_app* app, rtgui_event_t *event)
 /************************************************************************/
 /* RTGUI IPC APIs                                                       */
 /************************************************************************/
+#ifdef RTGUI_USING_EVENT_RING
+#define _rtgui_app_post(app, event, size)           \
+    rtgui_event_ring_put(&(app)->ring, (event), (size))
+/* there is no front of the ring, urgent event is put in order */
+#define _rtgui_app_post_urgent(app, event, size)    \
+    rtgui_event_ring_put(&(app)->ring, (event), (size))
+#define _rtgui_app_wait(app, event, size, timeout)  \
+    rtgui_event_ring_get(&(app)->ring, (event), (size), (timeout))
+#else
+#define _rtgui_app_post(app, event, size)           \
+    rt_mq_send((app)->mq, (event), (size))
+#define _rtgui_app_post_urgent(app, event, size)    \
+    rt_mq_urgent((app)->mq, (event), (size))
+#define _rtgui_app_wait(app, event, size, timeout)  \
+    rt_mq_recv((app)->mq, (event), (size), (timeout))
+#endif
+
 rt_err_t rtgui_send(struct rtgui_app* app, rtgui_event_t *event, rt_size_t event_size)
 {
     rt_err_t result;
@@ -570,7 +601,7 @@ rt_err_t rtgui_send(struct rtgui_app* app, rtgui_event_t *event, rt_size_t event
 
     rtgui_event_dump(app, event);
 
-    result = rt_mq_send(app->mq, event, event_size);
+    result = _rtgui_app_post(app, event, event_size);
     if (result != RT_EOK)
     {
         if (event->type != RTGUI_EVENT_TIMER)
@@ -591,7 +622,7 @@ rt_err_t rtgui_send_urgent(struct rtgui_app* app, rtgui_event_t *event, rt_size_
 
     rtgui_event_dump(app, event);
 
-    result = rt_mq_urgent(app->mq, event, event_size);
+    result = _rtgui_app_post_urgent(app, event, event_size);
     if (result != RT_EOK)
         rt_kprintf("send ergent event to %s failed\n", app->name);
 
@@ -599,6 +630,75 @@ rt_err_t rtgui_send_urgent(struct rtgui_app* app, rtgui_event_t *event, rt_size_
 }
 RTM_EXPORT(rtgui_send_urgent);
 
+#ifdef RTGUI_USING_ASYNC_ACK
+rt_err_t rtgui_send_async(struct rtgui_app* app, rtgui_event_t *event, rt_size_t event_size,
+                          rtgui_ack_t *ack)
+{
+    int index;
+    rt_err_t r;
+    struct rtgui_app *self;
+    struct rtgui_ack_chan *chan;
+
+    RT_ASSERT(app != RT_NULL);
+    RT_ASSERT(event != RT_NULL);
+    RT_ASSERT(event_size != 0);
+    RT_ASSERT(ack != RT_NULL);
+
+    /* the channels are only used by the thread of application */
+    self = rtgui_app_self();
+    if (self == RT_NULL)
+        return -RT_EBUSY;
+
+    chan = RT_NULL;
+    for (index = 0; index < RTGUI_APP_ACK_NUM; index ++)
+    {
+        if (self->acks[index].busy == RT_FALSE)
+        {
+            chan = &self->acks[index];
+            break;
+        }
+    }
+    if (chan == RT_NULL)
+        return -RT_EBUSY;
+
+    rtgui_event_dump(app, event);
+
+    event->ack = &chan->mb;
+    r = _rtgui_app_post(app, event, event_size);
+    if (r != RT_EOK)
+    {
+        rt_kprintf("send sync event failed\n");
+        return r;
+    }
+
+    chan->busy = RT_TRUE;
+    *ack = chan;
+
+    return RT_EOK;
+}
+RTM_EXPORT(rtgui_send_async);
+
+rt_err_t rtgui_ack_wait(rtgui_ack_t ack)
+{
+    rt_err_t r;
+    rt_int32_t ack_status;
+
+    RT_ASSERT(ack != RT_NULL);
+    RT_ASSERT(ack->busy == RT_TRUE);
+
+    r = rt_mb_recv(&ack->mb, (rt_uint32_t *)&ack_status, RT_WAITING_FOREVER);
+    ack->busy = RT_FALSE;
+    if (r != RT_EOK)
+        return r;
+
+    if (ack_status != RTGUI_STATUS_OK)
+        return -RT_ERROR;
+
+    return RT_EOK;
+}
+RTM_EXPORT(rtgui_ack_wait);
+#endif
+
 rt_err_t rtgui_send_sync(struct rtgui_app* app, rtgui_event_t *event, rt_size_t event_size)
 {
     rt_err_t r;
@@ -609,6 +709,20 @@ rt_err_t rtgui_send_sync(struct rtgui_app* app, rtgui_event_t *event, rt_size_t
     RT_ASSERT(event != RT_NULL);
     RT_ASSERT(event_size != 0);
 
+#ifdef RTGUI_USING_ASYNC_ACK
+    {
+        rtgui_ack_t ack;
+
+        /* the thread without application, or without free channel, uses a
+         * mailbox on stack */
+        r = rtgui_send_async(app, event, event_size, &ack);
+        if (r == RT_EOK)
+            return rtgui_ack_wait(ack);
+        else if (r != -RT_EBUSY)
+            return r;
+    }
+#endif
+
     rtgui_event_dump(app, event);
 
     /* init ack mailbox */
@@ -617,7 +731,7 @@ rt_err_t rtgui_send_sync(struct rtgui_app* app, rtgui_event_t *event, rt_size_t
         goto __return;
 
     event->ack = &ack_mb;
-    r = rt_mq_send(app->mq, event, event_size);
+    r = _rtgui_app_post(app, event, event_size);
     if (r != RT_EOK)
     {
         rt_kprintf("send sync event failed\n");
@@ -663,7 +777,7 @@ rt_err_t rtgui_recv(rtgui_event_t *event, rt_size_t event_size)
     if (app == RT_NULL)
         return -RT_ERROR;
 
-    r = rt_mq_recv(app->mq, event, event_size, RT_WAITING_FOREVER);
+    r = _rtgui_app_wait(app, event, event_size, RT_WAITING_FOREVER);
 
     return r;
 }
@@ -681,7 +795,7 @@ rt_err_t rtgui_recv_nosuspend(rtgui_event_t *event, rt_size_t event_size)
     if (app == RT_NULL)
         return -RT_ERROR;
 
-    r = rt_mq_recv(app->mq, event, event_size, 0);
+    r = _rtgui_app_wait(app, event, event_size, 0);
 
     return r;
 }
@@ -699,9 +813,33 @@ rt_err_t rtgui_recv_filter(rt_uint32_t type, rtgui_event_t *event, rt_size_t eve
     if (app == RT_NULL)
         return -RT_ERROR;
 
+#ifdef RTGUI_USING_EVENT_LANES
+    /* it may be pulled into lanes already */
+    if (rtgui_app_lane_take(app, type, event, event_size) == RT_EOK)
+        return RT_EOK;
+#endif
+
 	e = (rtgui_event_t*)&app->event_buffer[0];
-    while (rt_mq_recv(app->mq, e, sizeof(union rtgui_event_generic), RT_WAITING_FOREVER) == RT_EOK)
+    while (_rtgui_app_wait(app, e, sizeof(union rtgui_event_generic), RT_WAITING_FOREVER) == RT_EOK)
     {
+#ifdef RTGUI_USING_EVENT_POOL
+        if (e->type == RTGUI_EVENT_POOLED)
+        {
+            rtgui_event_t *pooled = ((struct rtgui_event_pooled *)e)->event;
+            rt_bool_t matched = (pooled->type == type);
+
+            /* the pooled event may be smaller than the buffer */
+            if (matched)
+                rt_memcpy(event, pooled, _UI_MIN(event_size, rtgui_event_get_size(pooled)));
+            else if (RTGUI_OBJECT(app)->event_handler != RT_NULL)
+                RTGUI_OBJECT(app)->event_handler(RTGUI_OBJECT(app), pooled);
+            rtgui_event_release(pooled);
+
+            if (matched)
+                return RT_EOK;
+            continue;
+        }
+#endif
         if (e->type == type)
         {
             rt_memcpy(event, e, event_size);
@@ -720,6 +858,153 @@ rt_err_t rtgui_recv_filter(rt_uint32_t type, rtgui_event_t *event, rt_size_t eve
 }
 RTM_EXPORT(rtgui_recv_filter);
 
+#ifdef RTGUI_USING_EVENT_POOL
+/************************************************************************/
+/* RTGUI Event Pool                                                     */
+/************************************************************************/
+struct rtgui_event_block
+{
+    rt_uint16_t ref_count;
+    /* the block is from heap */
+    rt_uint16_t heap;
+    /* the size of event, it keeps the event aligned to pointer too */
+    rt_size_t size;
+};
+
+static struct rt_mempool _event_pool;
+static rt_uint8_t _event_pool_buffer[RTGUI_EVENT_POOL_BLOCKS *
+                                     (RTGUI_EVENT_POOL_BLOCK_SIZE + sizeof(struct rtgui_event_block) + sizeof(void *))];
+static struct rtgui_event_pool_stat _event_pool_stat;
+
+static void rtgui_event_pool_init(void)
+{
+    rt_mp_init(&_event_pool, "gevent", _event_pool_buffer, sizeof(_event_pool_buffer),
+               RTGUI_EVENT_POOL_BLOCK_SIZE + sizeof(struct rtgui_event_block));
+}
+
+#define _event_block(event)     ((struct rtgui_event_block *)(event) - 1)
+
+struct rtgui_event *rtgui_event_alloc(rt_size_t size)
+{
+    rt_base_t level;
+    struct rtgui_event_block *block = RT_NULL;
+
+    RT_ASSERT(size >= sizeof(struct rtgui_event));
+
+    if (size <= RTGUI_EVENT_POOL_BLOCK_SIZE)
+        block = rt_mp_alloc(&_event_pool, 0);
+    if (block != RT_NULL)
+    {
+        block->heap = 0;
+    }
+    else
+    {
+        /* too large or the pool is used up */
+        block = rtgui_malloc(sizeof(struct rtgui_event_block) + size);
+        if (block == RT_NULL)
+            return RT_NULL;
+        block->heap = 1;
+    }
+    block->ref_count = 1;
+    block->size = size;
+
+    level = rt_hw_interrupt_disable();
+    if (block->heap)
+        _event_pool_stat.heap ++;
+    else
+        _event_pool_stat.pooled ++;
+    _event_pool_stat.used ++;
+    rt_hw_interrupt_enable(level);
+
+    return (struct rtgui_event *)(block + 1);
+}
+RTM_EXPORT(rtgui_event_alloc);
+
+void rtgui_event_ref(struct rtgui_event *event)
+{
+    rt_base_t level;
+
+    RT_ASSERT(event != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    _event_block(event)->ref_count ++;
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rtgui_event_ref);
+
+rt_size_t rtgui_event_get_size(struct rtgui_event *event)
+{
+    RT_ASSERT(event != RT_NULL);
+
+    return _event_block(event)->size;
+}
+RTM_EXPORT(rtgui_event_get_size);
+
+void rtgui_event_release(struct rtgui_event *event)
+{
+    rt_base_t level;
+    rt_uint16_t ref_count;
+    struct rtgui_event_block *block;
+
+    RT_ASSERT(event != RT_NULL);
+
+    block = _event_block(event);
+    RT_ASSERT(block->ref_count != 0);
+
+    level = rt_hw_interrupt_disable();
+    ref_count = -- block->ref_count;
+    if (ref_count == 0)
+        _event_pool_stat.used --;
+    rt_hw_interrupt_enable(level);
+
+    if (ref_count != 0)
+        return;
+
+    if (block->heap)
+        rtgui_free(block);
+    else
+        rt_mp_free(block);
+}
+RTM_EXPORT(rtgui_event_release);
+
+rt_err_t rtgui_send_pooled(struct rtgui_app *app, struct rtgui_event *event)
+{
+    rt_err_t result;
+    struct rtgui_event_pooled epooled;
+
+    RT_ASSERT(app != RT_NULL);
+    RT_ASSERT(event != RT_NULL);
+
+    RTGUI_EVENT_POOLED_INIT(&epooled);
+    epooled.event = event;
+
+    result = rtgui_send(app, &(epooled.parent), sizeof(epooled));
+    if (result != RT_EOK)
+        rtgui_event_release(event);
+
+    return result;
+}
+RTM_EXPORT(rtgui_send_pooled);
+
+void rtgui_event_get_pool_stat(struct rtgui_event_pool_stat *stat)
+{
+    RT_ASSERT(stat != RT_NULL);
+
+    *stat = _event_pool_stat;
+}
+RTM_EXPORT(rtgui_event_get_pool_stat);
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+void list_event_pool(void)
+{
+    rt_kprintf("events: %d from pool, %d from heap, %d in use\n",
+               _event_pool_stat.pooled, _event_pool_stat.heap, _event_pool_stat.used);
+}
+FINSH_FUNCTION_EXPORT(list_event_pool, display pooled event statistics);
+#endif
+#endif
+
 void rtgui_set_mainwin_rect(struct rtgui_rect *rect)
 {
     _mainwin_rect = *rect;
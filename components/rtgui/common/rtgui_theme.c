@@ -14,6 +14,7 @@
 
 #include <rtgui/rtgui.h>
 #include <rtgui/dc.h>
+#include <rtgui/dc_record.h>
 #include <rtgui/widgets/widget.h>
 #include <rtgui/widgets/button.h>
 #include <rtgui/widgets/label.h>
@@ -285,6 +286,27 @@ void rtgui_theme_draw_button(rtgui_button_t *btn)
     rtgui_dc_end_drawing(dc);
 }
 
+#ifdef RTGUI_USING_DC_RECORD
+/* whether the record is drawn in the same size and gc of widget */
+static rt_bool_t _theme_record_valid(struct rtgui_dc *record,
+                                     struct rtgui_widget *widget, rtgui_rect_t *rect)
+{
+    rtgui_rect_t record_rect;
+    rtgui_gc_t *gc = rtgui_dc_get_gc(record);
+
+    rtgui_dc_get_rect(record, &record_rect);
+    if (rtgui_rect_width(record_rect) != rtgui_rect_width(*rect) ||
+        rtgui_rect_height(record_rect) != rtgui_rect_height(*rect))
+        return RT_FALSE;
+
+    return (gc->foreground == widget->gc.foreground &&
+            gc->background == widget->gc.background &&
+            gc->textstyle == widget->gc.textstyle &&
+            gc->textalign == widget->gc.textalign &&
+            gc->font == widget->gc.font);
+}
+#endif
+
 void rtgui_theme_draw_label(rtgui_label_t *label)
 {
     /* draw label */
@@ -296,6 +318,33 @@ void rtgui_theme_draw_label(rtgui_label_t *label)
     if (dc == RT_NULL) return;
 
     rtgui_widget_get_rect(RTGUI_WIDGET(label), &rect);
+#ifdef RTGUI_USING_DC_RECORD
+    if (label->record != RT_NULL && !_theme_record_valid(label->record,
+            RTGUI_WIDGET(label), &rect))
+    {
+        rtgui_dc_destory(label->record);
+        label->record = RT_NULL;
+    }
+
+    if (label->record == RT_NULL)
+        label->record = rtgui_dc_record_create(rtgui_rect_width(rect),
+                                               rtgui_rect_height(rect));
+
+    if (label->record != RT_NULL)
+    {
+        if (rtgui_dc_record_get_size(label->record) == 0)
+        {
+            /* record the label once, replay it on the later paint */
+            rtgui_dc_set_gc(label->record, &(RTGUI_WIDGET(label)->gc));
+            rtgui_dc_fill_rect(label->record, &rect);
+            rtgui_dc_draw_text(label->record, rtgui_label_get_text(label), &rect);
+        }
+
+        rtgui_dc_record_replay(label->record, RT_NULL, dc, &rect);
+        rtgui_dc_end_drawing(dc);
+        return;
+    }
+#endif
     rtgui_dc_fill_rect(dc, &rect);
 
     /* default left and center draw */
@@ -206,6 +206,15 @@ extern const rt_uint8_t* rtgui_blit_expand_byte[9];
 typedef void (*rtgui_blit_line_func)(rt_uint8_t *dst, rt_uint8_t *src, int line);
 rtgui_blit_line_func rtgui_blit_line_get(int dst_bpp, int src_bpp);
 rtgui_blit_line_func rtgui_blit_line_get_inv(int dst_bpp, int src_bpp);
+/* get the converter in C, whatever SIMD converter is installed */
+rtgui_blit_line_func rtgui_blit_line_get_generic(int dst_bpp, int src_bpp);
+/* install the SIMD converters supported by cpu */
+void rtgui_blit_line_init(void);
+
+/* fill count pixels of 2, 3 (B, G, R) or 4 bytes with one pixel value */
+void rtgui_blit_fill_2(rt_uint8_t *dst, rt_uint32_t pixel, int count);
+void rtgui_blit_fill_3(rt_uint8_t *dst, rt_uint32_t pixel, int count);
+void rtgui_blit_fill_4(rt_uint8_t *dst, rt_uint32_t pixel, int count);
 
 void rtgui_blit(struct rtgui_blit_info * info);
 
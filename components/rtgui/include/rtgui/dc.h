@@ -30,6 +30,7 @@ enum rtgui_dc_type
     RTGUI_DC_HW,
     RTGUI_DC_CLIENT,
     RTGUI_DC_BUFFER,
+    RTGUI_DC_RECORD,
 };
 
 struct rtgui_dc_engine
@@ -42,6 +43,9 @@ struct rtgui_dc_engine
     void (*fill_rect)(struct rtgui_dc *dc, rtgui_rect_t *rect);
     void (*blit_line)(struct rtgui_dc *dc, int x1, int x2, int y, rt_uint8_t *line_data);
     void (*blit)(struct rtgui_dc *dc, struct rtgui_point *dc_point, struct rtgui_dc *dest, rtgui_rect_t *rect);
+    /* draw 1bpp mask with one clip test, optional. RT_NULL to draw it in hlines */
+    void (*blit_mono)(struct rtgui_dc *dc, int x, int y, int w, int h,
+                      const rt_uint8_t *mask, int pitch, rt_bool_t background);
 
     rt_bool_t (*fini)(struct rtgui_dc *dc);
 };
@@ -123,6 +127,8 @@ void rtgui_dc_draw_text_stroke(struct rtgui_dc *dc, const char *text, struct rtg
                                rtgui_color_t color_stroke, rtgui_color_t color_core);
 
 void rtgui_dc_draw_mono_bmp(struct rtgui_dc *dc, int x, int y, int w, int h, const rt_uint8_t *data);
+void rtgui_dc_blit_mono_runs(struct rtgui_dc *dc, int x, int y, int w, int h,
+                             const rt_uint8_t *mask, int pitch, rt_bool_t background);
 void rtgui_dc_draw_byte(struct rtgui_dc *dc, int x, int y, int h, const rt_uint8_t *data);
 void rtgui_dc_draw_word(struct rtgui_dc *dc, int x, int y, int h, const rt_uint8_t *data);
 
@@ -206,6 +212,45 @@ rt_inline void rtgui_dc_fill_rect(struct rtgui_dc *dc, struct rtgui_rect *rect)
     dc->engine->fill_rect(dc, rect);
 }
 
+/*
+ * draw a 1bpp mask (MSB first, pitch bytes for each row) on dc. The set bits
+ * are drawn with foreground, and the clear bits with background when
+ * background is RT_TRUE.
+ */
+rt_inline void rtgui_dc_blit_mono(struct rtgui_dc *dc, int x, int y, int w, int h,
+                                  const rt_uint8_t *mask, int pitch, rt_bool_t background)
+{
+    if (dc->engine->blit_mono != RT_NULL)
+        dc->engine->blit_mono(dc, x, y, w, h, mask, pitch, background);
+    else
+        rtgui_dc_blit_mono_runs(dc, x, y, w, h, mask, pitch, background);
+}
+
+/*
+ * get the end of the run of same bits from bit start in a row of 1bpp mask
+ */
+rt_inline int rtgui_dc_mono_run(const rt_uint8_t *row, int start, int end)
+{
+    rt_uint8_t bit, fill;
+
+    bit = row[start >> 3] & (0x80 >> (start & 0x07));
+    fill = bit ? 0xFF : 0x00;
+    while (++start < end)
+    {
+        /* skip the whole byte */
+        if ((start & 0x07) == 0 && start + 8 <= end && row[start >> 3] == fill)
+        {
+            start += 7;
+            continue;
+        }
+
+        if (((row[start >> 3] & (0x80 >> (start & 0x07))) != 0) != (bit != 0))
+            break;
+    }
+
+    return start;
+}
+
 /*
  * blit a dc (x, y) on another dc(rect)
  */
@@ -0,0 +1,57 @@
+/*
+ * File      : dc_record.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2013, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ */
+#ifndef __RTGUI_DC_RECORD_H__
+#define __RTGUI_DC_RECORD_H__
+
+#include <rtgui/dc.h>
+
+/*
+ * The record dc does not touch any pixel. It appends the drawing commands to
+ * an arena, which could be replayed on another dc later. The replay does not
+ * run the layout, font or theme code again.
+ */
+struct rtgui_dc_record
+{
+    struct rtgui_dc parent;
+
+    /* graphic context */
+    rtgui_gc_t gc;
+
+    /* pixel format of the recorded line data */
+    rt_uint8_t pixel_format;
+
+    /* width and height */
+    rt_uint16_t width, height;
+
+    /* the command arena */
+    rt_uint8_t *arena;
+    rt_uint32_t arena_size;
+    rt_uint32_t arena_used;
+
+    /* offset of the last command, to merge the runs */
+    rt_uint32_t last_cmd;
+};
+
+/* create a record dc */
+struct rtgui_dc *rtgui_dc_record_create(int width, int height);
+/* drop all the recorded commands */
+void rtgui_dc_record_reset(struct rtgui_dc *dc);
+/* get the size of recorded commands in bytes */
+rt_uint32_t rtgui_dc_record_get_size(struct rtgui_dc *dc);
+
+/*
+ * replay the commands on dest, the (dc_point) of record dc is put on the
+ * (rect->x1, rect->y1) of dest and the commands are clipped to rect. Same as
+ * rtgui_dc_blit on a record dc.
+ */
+void rtgui_dc_record_replay(struct rtgui_dc *dc, struct rtgui_point *dc_point,
+                            struct rtgui_dc *dest, rtgui_rect_t *rect);
+
+#endif
@@ -29,6 +29,9 @@ struct rtgui_graphic_driver_ops
 
     /* draw raw hline */
     void (*draw_raw_hline)(rt_uint8_t *pixels, int x1, int x2, int y);
+
+    /* fill rect [x1, x2) x [y1, y2), optional. RT_NULL to use draw_hline */
+    void (*fill_rect)(rtgui_color_t *c, int x1, int y1, int x2, int y2);
 };
 
 /* graphic extension operations */
@@ -80,6 +83,39 @@ rt_inline struct rtgui_graphic_driver *rtgui_graphic_get_device()
 	return rtgui_graphic_driver_get_default();
 }
 
+/* fill a device rect, fall back to hline when the driver has no fill_rect */
+rt_inline void rtgui_graphic_driver_fill_rect(const struct rtgui_graphic_driver *driver,
+                                              rtgui_color_t *c, rtgui_rect_t *rect)
+{
+	int y;
+
+	if (driver->ops->fill_rect != RT_NULL)
+	{
+		driver->ops->fill_rect(c, rect->x1, rect->y1, rect->x2, rect->y2);
+		return;
+	}
+
+	for (y = rect->y1; y < rect->y2; y ++)
+		driver->ops->draw_hline(c, rect->x1, rect->x2, y);
+}
+
+/* write out the drawing batched by driver, when the drawing ends */
+void rtgui_graphic_driver_flush(const struct rtgui_graphic_driver *driver);
+
+#ifdef RTGUI_USING_PIXEL_BATCH
+/* statistics of pixel device batching */
+struct rtgui_pixel_batch_stat
+{
+    /* writes to driver ops and calls to device ops. The calls saved by
+     * batching are writes - calls */
+    rt_uint32_t writes;
+    rt_uint32_t calls;
+};
+
+void rtgui_pixel_device_flush(void);
+void rtgui_pixel_device_get_stat(struct rtgui_pixel_batch_stat *stat);
+#endif
+
 #ifdef RTGUI_USING_HW_CURSOR
 /*
  * hardware cursor
@@ -103,5 +139,17 @@ struct rtgui_dc* rtgui_graphic_driver_get_rect_buffer(const struct rtgui_graphic
 
 rt_bool_t rtgui_graphic_driver_is_vmode(void);
 
+#ifdef RTGUI_USING_COMPOSITOR
+/* offscreen surface of a window in the pixel format of driver, drawn in
+ * screen coordinates over rect */
+struct rtgui_graphic_driver *rtgui_graphic_driver_surface_create(const struct rtgui_graphic_driver *driver,
+                                                                  rtgui_rect_t *rect);
+void rtgui_graphic_driver_surface_destroy(struct rtgui_graphic_driver *surface);
+/* move the surface to (x, y) of screen, the pixels are kept */
+void rtgui_graphic_driver_surface_moveto(struct rtgui_graphic_driver *surface, int x, int y);
+/* the first pixel of surface */
+rt_uint8_t *rtgui_graphic_driver_surface_pixel(const struct rtgui_graphic_driver *surface);
+#endif
+
 #endif
 
@@ -76,6 +76,9 @@ enum _rtgui_event_type
     RTGUI_EVENT_UNSELECTED,            /* widget un-selected    */
     RTGUI_EVENT_MV_MODEL,              /* data of a model has been changed */
 
+    /* pointer of a pooled event */
+    RTGUI_EVENT_POOLED,                /* pooled event          */
+
     /* user command event. It should always be the last command type. */
     RTGUI_EVENT_COMMAND = 0x0100,        /* user command          */
 };
@@ -210,6 +213,8 @@ struct rtgui_event_update_end
 
     /* the update rect */
     rtgui_rect_t rect;
+    /* the window drawn */
+    struct rtgui_win *wid;
 };
 
 struct rtgui_event_monitor
@@ -303,6 +308,12 @@ struct rtgui_event_mouse
 
     rt_uint16_t x, y;
     rt_uint16_t button;
+#ifdef RTGUI_USING_MOTION_COALESCE
+    /* motion event only: the number of samples merged into this one and the
+     * sequence number of this sample */
+    rt_uint16_t merged;
+    rt_uint32_t seq;
+#endif
 };
 #define RTGUI_MOUSE_BUTTON_LEFT         0x01
 #define RTGUI_MOUSE_BUTTON_RIGHT        0x02
@@ -487,6 +498,20 @@ _RTGUI_EVENT_MV_IS_TYPE(CHANGED);
 _RTGUI_EVENT_MV_IS_TYPE(DELETED);
 #undef _RTGUI_EVENT_MV_IS_TYPE
 
+/*
+ * RTGUI Pooled Event
+ *
+ * Only the pointer of an event from rtgui_event_alloc goes through the queue.
+ * The application handles the event it points to and releases it.
+ */
+struct rtgui_event_pooled
+{
+    struct rtgui_event parent;
+
+    struct rtgui_event *event;
+};
+#define RTGUI_EVENT_POOLED_INIT(e)  RTGUI_EVENT_INIT(&((e)->parent), RTGUI_EVENT_POOLED)
+
 #undef _RTGUI_EVENT_WIN_ELEMENTS
 
 union rtgui_event_generic
@@ -526,6 +551,7 @@ union rtgui_event_generic
     struct rtgui_event_focused focused;
     struct rtgui_event_resize resize;
     struct rtgui_event_mv_model model;
+    struct rtgui_event_pooled pooled;
     struct rtgui_event_command command;
 };
 #endif
@@ -0,0 +1,57 @@
+/*
+ * File      : event_ring.h
+ * This file is part of RT-Thread RTOS
+ * COPYRIGHT (C) 2006 - 2013, RT-Thread Development Team
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rt-thread.org/license/LICENSE
+ */
+#ifndef __RTGUI_EVENT_RING_H__
+#define __RTGUI_EVENT_RING_H__
+
+#include <rtthread.h>
+#include <rtgui/rtgui.h>
+#include <rtgui/event.h>
+
+/*
+ * The event ring is a bounded queue of events with many senders and one
+ * receiver, the thread of application. The senders claim a slot by compare
+ * and swap of the head, and the receiver owns the tail. Each slot has a
+ * sequence number telling whether it's free or filled for the turn of ring.
+ *
+ * The receiver only waits on the semaphore when the ring is empty, and the
+ * senders only release it when the receiver is parked.
+ */
+struct rtgui_event_ring_slot
+{
+    volatile rt_uint32_t seq;
+    union rtgui_event_generic event;
+};
+
+struct rtgui_event_ring
+{
+    struct rtgui_event_ring_slot *slots;
+    /* the number of slots, power of 2 */
+    rt_uint32_t size;
+
+    /* next slot to fill, claimed by senders */
+    volatile rt_uint32_t head;
+    /* next slot to read, only used by receiver */
+    rt_uint32_t tail;
+
+    /* receiver is waiting on the semaphore */
+    volatile rt_uint32_t parked;
+    struct rt_semaphore sem;
+};
+
+rt_err_t rtgui_event_ring_init(struct rtgui_event_ring *ring, const char *name, rt_uint32_t size);
+void rtgui_event_ring_fini(struct rtgui_event_ring *ring);
+
+/* return -RT_EFULL if there is no free slot */
+rt_err_t rtgui_event_ring_put(struct rtgui_event_ring *ring, rtgui_event_t *event, rt_size_t event_size);
+/* wait at most timeout ticks for an event, -RT_ETIMEOUT if ring is still empty */
+rt_err_t rtgui_event_ring_get(struct rtgui_event_ring *ring, rtgui_event_t *event, rt_size_t event_size,
+                              rt_int32_t timeout);
+
+#endif
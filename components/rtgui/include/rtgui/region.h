@@ -26,6 +26,8 @@ struct rtgui_region_data
 {
     rt_uint32_t size;
     rt_uint32_t numRects;
+    /* the box of last point found, checked before searching */
+    rt_uint32_t hit;
     /* XXX: And why, exactly, do we have this bogus struct definition? */
     /* rtgui_rect_t rects[size]; in memory but not explicitly declared */
 };
@@ -83,6 +85,22 @@ void rtgui_region_reset(rtgui_region_t *region, rtgui_rect_t *rect);
 void rtgui_region_empty(rtgui_region_t *region);
 void rtgui_region_dump(rtgui_region_t *region);
 int rtgui_region_is_flat(rtgui_region_t *region);
+int rtgui_region_is_equal(rtgui_region_t *reg1, rtgui_region_t *reg2);
+
+#ifdef RTGUI_USING_REGION_POOL
+/* statistics of region rect arrays */
+struct rtgui_region_pool_stat
+{
+    /* the arrays allocated from pool and heap, a resize counts again */
+    rt_uint32_t pooled;
+    rt_uint32_t heap;
+    /* the arrays not freed yet */
+    rt_uint32_t used;
+};
+
+void rtgui_region_pool_init(void);
+void rtgui_region_get_pool_stat(struct rtgui_region_pool_stat *stat);
+#endif
 
 /* rect functions */
 extern rtgui_rect_t rtgui_empty_rect;
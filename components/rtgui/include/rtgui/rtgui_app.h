@@ -19,6 +19,9 @@
 #include <rtgui/rtgui.h>
 #include <rtgui/event.h>
 #include <rtgui/rtgui_system.h>
+#ifdef RTGUI_USING_EVENT_RING
+#include <rtgui/event_ring.h>
+#endif
 
 DECLARE_CLASS_TYPE(application);
 
@@ -35,6 +38,42 @@ enum rtgui_app_flag
     RTGUI_APP_FLAG_SHOWN   = 0x08
 };
 
+#ifdef RTGUI_USING_EVENT_LANES
+/* the event lanes, in the order of priority */
+enum rtgui_app_lane_type
+{
+    RTGUI_APP_LANE_INPUT,       /* mouse, keyboard, touch and gesture */
+    RTGUI_APP_LANE_WINDOW,      /* application, window and widget state */
+    RTGUI_APP_LANE_PAINT,       /* paint and update */
+    RTGUI_APP_LANE_OTHER,       /* timer, model, command and the others */
+
+    RTGUI_APP_LANE_MAX
+};
+
+struct rtgui_app_lane_stat
+{
+    /* the events in lane now, and the most ever */
+    rt_uint16_t depth;
+    rt_uint16_t max_depth;
+
+    /* the events handled, and the ticks they waited in lane */
+    rt_uint32_t handled;
+    rt_uint32_t total_wait;
+    rt_uint32_t max_wait;
+};
+
+struct rtgui_app_lane
+{
+    union rtgui_event_generic events[RTGUI_APP_LANE_DEPTH];
+    /* the tick when event entered lane */
+    rt_tick_t ticks[RTGUI_APP_LANE_DEPTH];
+    /* the first event, and the number of events is stat.depth */
+    rt_uint16_t first;
+
+    struct rtgui_app_lane_stat stat;
+};
+#endif
+
 typedef void (*rtgui_idle_func_t)(struct rtgui_object *obj, struct rtgui_event *event);
 
 struct rtgui_app
@@ -52,8 +91,13 @@ struct rtgui_app
 
     /* the thread id */
     rt_thread_t tid;
+#ifdef RTGUI_USING_EVENT_RING
+    /* the event ring of thread */
+    struct rtgui_event_ring ring;
+#else
     /* the message queue of thread */
     rt_mq_t mq;
+#endif
     /* event buffer */
     rt_uint8_t event_buffer[sizeof(union rtgui_event_generic)];
 
@@ -64,6 +108,33 @@ struct rtgui_app
 
     /* on idle event handler */
     rtgui_idle_func_t on_idle;
+
+#ifdef RTGUI_USING_ASYNC_ACK
+    /* the channels for acks of synchronous events */
+    struct rtgui_ack_chan acks[RTGUI_APP_ACK_NUM];
+#endif
+
+#ifdef RTGUI_USING_ID_HASH
+    /* the objects with an ID set, in 1 << id_bits buckets */
+    struct rtgui_object **id_buckets;
+    rt_uint8_t id_bits;
+    rt_uint32_t id_count;
+#endif
+
+#ifdef RTGUI_USING_DEFERRED_PAINT
+    /* the windows with invalidated widgets, and the tick of the first one */
+    struct rtgui_win *dirty_wins;
+    rt_tick_t dirty_tick;
+#endif
+
+#ifdef RTGUI_USING_EVENT_LANES
+    struct rtgui_app_lane lanes[RTGUI_APP_LANE_MAX];
+#endif
+
+#ifdef RTGUI_USING_COMPOSITOR
+    /* the surface of window in drawing */
+    struct rtgui_graphic_driver *surface;
+#endif
 };
 
 /**
@@ -85,6 +156,26 @@ void rtgui_app_close(struct rtgui_app *app);
 void rtgui_app_set_onidle(struct rtgui_app *app, rtgui_idle_func_t onidle);
 rtgui_idle_func_t rtgui_app_get_onidle(struct rtgui_app *app);
 
+#ifdef RTGUI_USING_DEFERRED_PAINT
+/* paint the invalidated widgets of all windows now */
+void rtgui_app_paint_dirty(struct rtgui_app *app);
+#endif
+
+#ifdef RTGUI_USING_ID_HASH
+/* the ID hash table, used by rtgui_object_set_id and rtgui_get_object */
+void rtgui_app_id_add(struct rtgui_app *app, struct rtgui_object *object);
+/* remove the object from the table of the application it was added to */
+void rtgui_app_id_remove(struct rtgui_object *object);
+struct rtgui_object *rtgui_app_id_find(struct rtgui_app *app, rt_uint32_t id);
+#endif
+
+#ifdef RTGUI_USING_EVENT_LANES
+void rtgui_app_get_lane_stat(struct rtgui_app *app, enum rtgui_app_lane_type lane,
+                             struct rtgui_app_lane_stat *stat);
+rt_err_t rtgui_app_lane_take(struct rtgui_app *app, rt_uint32_t type,
+                             struct rtgui_event *event, rt_size_t event_size);
+#endif
+
 /**
  * return the rtgui_app struct on current thread
  */
@@ -45,7 +45,11 @@
 #define RTGUI_APP_THREAD_STACK_SIZE     2048
 #endif
 
+/* check the casts of objects and print the invalid ones in debug builds,
+ * the release builds take the casts as they are */
+#ifdef RT_DEBUG
 #define RTGUI_USING_CAST_CHECK
+#endif
 
 //#define RTGUI_USING_DESKTOP_WINDOW
 //#undef RTGUI_USING_SMALL_SIZE
@@ -54,5 +58,167 @@
 
 #define RTGUI_USING_VFRAMEBUFFER
 
+/* merge the screen updates in server and flush them when the server goes
+ * idle or once in a frame */
+#define RTGUI_USING_UPDATE_DAMAGE
+#ifndef RTGUI_UPDATE_FRAME_TICKS
+#define RTGUI_UPDATE_FRAME_TICKS        ((RT_TICK_PER_SECOND + 29) / 30)
+#endif
+/* flush the extents of damage when it is split into more rects */
+#ifndef RTGUI_UPDATE_DAMAGE_MAX_RECTS
+#define RTGUI_UPDATE_DAMAGE_MAX_RECTS   16
+#endif
+
+/* use the SSE2/SSSE3/AVX2/NEON pixel format converters when compiler supports */
+#define RTGUI_USING_BLIT_SIMD
+
+/* each shown window draws to its own surface and server composes the damaged
+ * region of the screen from them. Move, raise and hide of windows do not need
+ * paint events anymore, but it takes a surface of the window size for each
+ * window. Need RTGUI_USING_UPDATE_DAMAGE */
+//#define RTGUI_USING_COMPOSITOR
+#ifndef RTGUI_COMPOSITOR_BACKGROUND
+#define RTGUI_COMPOSITOR_BACKGROUND     RTGUI_RGB(0x00, 0x00, 0x00)
+#endif
+#if defined(RTGUI_USING_COMPOSITOR) && !defined(RTGUI_USING_UPDATE_DAMAGE)
+#error RTGUI_USING_COMPOSITOR needs RTGUI_USING_UPDATE_DAMAGE
+#endif
+
+/* keep the pixels of the windows with RTGUI_WIN_STYLE_BACKING_STORE in server,
+ * and restore the exposed area from them instead of sending paint event. The
+ * backing buffers take at most RTGUI_BACKING_STORE_BUDGET bytes in total */
+#if !defined(RTGUI_USING_SMALL_SIZE) && !defined(RTGUI_USING_COMPOSITOR)
+#define RTGUI_USING_BACKING_STORE
+#endif
+#ifndef RTGUI_BACKING_STORE_BUDGET
+#define RTGUI_BACKING_STORE_BUDGET      (512 * 1024)
+#endif
+
+/* batch the pixels and hlines written to a pixel device (no framebuffer)
+ * into line spans of RTGUI_PIXEL_BATCH_SIZE pixels, written by blit_line */
+#define RTGUI_USING_PIXEL_BATCH
+#ifndef RTGUI_PIXEL_BATCH_SIZE
+#define RTGUI_PIXEL_BATCH_SIZE          128
+#endif
+
+/* cache the drawing of simple widgets in record dc and replay it on paint */
+#ifndef RTGUI_USING_SMALL_SIZE
+#define RTGUI_USING_DC_RECORD
+#endif
+
+/* mark the widget clips out of date when the window clip or the layout
+ * changes, and compute the clip of a widget only when it begins drawing */
+#define RTGUI_USING_LAZY_CLIP
+
+/* merge the mouse motion events to the same window in server, only the latest
+ * position is sent when server is idle or in RTGUI_MOTION_COALESCE_TICKS. The
+ * last RTGUI_MOTION_HISTORY_SIZE samples are kept for the applications which
+ * want the merged positions */
+#define RTGUI_USING_MOTION_COALESCE
+#ifndef RTGUI_MOTION_COALESCE_TICKS
+#define RTGUI_MOTION_COALESCE_TICKS     ((RT_TICK_PER_SECOND + 59) / 60)
+#endif
+#ifndef RTGUI_MOTION_HISTORY_SIZE
+#define RTGUI_MOTION_HISTORY_SIZE       16
+#endif
+
+/* send the events to application through a lock free ring of
+ * RTGUI_EVENT_RING_SIZE events instead of rt_mq. The urgent events are not
+ * put to the front of ring */
+//#define RTGUI_USING_EVENT_RING
+#ifndef RTGUI_EVENT_RING_SIZE
+#define RTGUI_EVENT_RING_SIZE           32
+#endif
+
+/* the events allocated by rtgui_event_alloc are sent by pointer, and released
+ * after the receiver handles them. The blocks up to RTGUI_EVENT_POOL_BLOCK_SIZE
+ * bytes come from a pool of RTGUI_EVENT_POOL_BLOCKS, larger ones from heap */
+#ifndef RTGUI_USING_SMALL_SIZE
+#define RTGUI_USING_EVENT_POOL
+#endif
+#ifndef RTGUI_EVENT_POOL_BLOCK_SIZE
+#define RTGUI_EVENT_POOL_BLOCK_SIZE     128
+#endif
+#ifndef RTGUI_EVENT_POOL_BLOCKS
+#define RTGUI_EVENT_POOL_BLOCKS         16
+#endif
+
+/* the application pulls the queued events into lanes of RTGUI_APP_LANE_DEPTH
+ * events: input, window, paint and the others, and handles the higher lane
+ * firstly. The event waited for RTGUI_APP_LANE_MAX_WAIT ticks goes first.
+ * The lanes are as deep as the queue of application, so a full queue fits in
+ * any lane; while a lane is full the rest stay in queue */
+#ifndef RTGUI_USING_SMALL_SIZE
+#define RTGUI_USING_EVENT_LANES
+#endif
+#ifndef RTGUI_APP_LANE_DEPTH
+#define RTGUI_APP_LANE_DEPTH            32
+#endif
+#ifndef RTGUI_APP_LANE_MAX_WAIT
+#define RTGUI_APP_LANE_MAX_WAIT         (RT_TICK_PER_SECOND / 10)
+#endif
+
+/* rtgui_widget_invalidate adds the area to the dirty region of window, which
+ * is painted when the application goes idle or once in
+ * RTGUI_UPDATE_FRAME_TICKS. The window keeps RTGUI_WIN_DIRTY_WIDGETS widgets
+ * to paint, more than that paint the whole window in the dirty region */
+#ifndef RTGUI_USING_SMALL_SIZE
+#define RTGUI_USING_DEFERRED_PAINT
+#endif
+#ifndef RTGUI_WIN_DIRTY_WIDGETS
+#define RTGUI_WIN_DIRTY_WIDGETS         8
+#endif
+
+/* each application keeps RTGUI_APP_ACK_NUM acknowledgement channels for the
+ * synchronous events instead of a new mailbox for every one, and can send
+ * that many events with rtgui_send_async before waiting for the acks */
+#ifndef RTGUI_USING_SMALL_SIZE
+#define RTGUI_USING_ASYNC_ACK
+#endif
+#ifndef RTGUI_APP_ACK_NUM
+#define RTGUI_APP_ACK_NUM               8
+#endif
+
+/* the rect arrays of regions up to RTGUI_REGION_POOL_SMALL and
+ * RTGUI_REGION_POOL_LARGE rects are taken from two pools of
+ * RTGUI_REGION_POOL_BLOCKS blocks, the larger ones from heap */
+#ifndef RTGUI_USING_SMALL_SIZE
+#define RTGUI_USING_REGION_POOL
+#endif
+#ifndef RTGUI_REGION_POOL_SMALL
+#define RTGUI_REGION_POOL_SMALL         16
+#endif
+#ifndef RTGUI_REGION_POOL_LARGE
+#define RTGUI_REGION_POOL_LARGE         64
+#endif
+#ifndef RTGUI_REGION_POOL_BLOCKS
+#define RTGUI_REGION_POOL_BLOCKS        8
+#endif
+
+/* the server finds the window at a point from a grid of
+ * RTGUI_TOPWIN_GRID x RTGUI_TOPWIN_GRID cells over the screen, rebuilt when
+ * the windows change. With more than 32 windows shown it walks the tree */
+#ifndef RTGUI_USING_SMALL_SIZE
+#define RTGUI_USING_TOPWIN_GRID
+#endif
+#ifndef RTGUI_TOPWIN_GRID
+#define RTGUI_TOPWIN_GRID               8
+#endif
+
+/* the objects given an ID by rtgui_object_set_id are kept in a hash table of
+ * the application, so finding them by ID needn't walk the windows */
+#ifndef RTGUI_USING_SMALL_SIZE
+#define RTGUI_USING_ID_HASH
+#endif
+
+/* each type keeps its ancestors, so the type checks needn't walk the parents.
+ * The types deeper than RTGUI_TYPE_DEPTH_MAX still walk them */
+#ifndef RTGUI_USING_SMALL_SIZE
+#define RTGUI_USING_TYPE_ANCESTORS
+#endif
+#ifndef RTGUI_TYPE_DEPTH_MAX
+#define RTGUI_TYPE_DEPTH_MAX            8
+#endif
+
 #endif
 
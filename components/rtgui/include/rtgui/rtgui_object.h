@@ -39,6 +39,16 @@ typedef struct rtgui_object rtgui_object_t;
 typedef void (*rtgui_constructor_t)(rtgui_object_t *object);
 typedef void (*rtgui_destructor_t)(rtgui_object_t *object);
 
+#ifdef RTGUI_USING_TYPE_ANCESTORS
+/* the ancestors of type from the root, filled in the first check of type */
+struct rtgui_type_info
+{
+    /* the number of ancestors with the type itself, 0 if not filled yet */
+    rt_uint8_t depth;
+    const struct rtgui_type *ancestors[RTGUI_TYPE_DEPTH_MAX];
+};
+#endif
+
 /* rtgui type structure */
 struct rtgui_type
 {
@@ -54,6 +64,11 @@ struct rtgui_type
 
     /* size of type */
     int size;
+
+#ifdef RTGUI_USING_TYPE_ANCESTORS
+    /* RT_NULL for the types walking the parents */
+    struct rtgui_type_info *info;
+#endif
 };
 typedef struct rtgui_type rtgui_type_t;
 #define RTGUI_TYPE(type)            (_rtgui_##type##_get_type())
@@ -63,6 +78,19 @@ typedef struct rtgui_type rtgui_type_t;
 	const rtgui_type_t *_rtgui_##type##_get_type(void); \
 	extern const struct rtgui_type _rtgui_##type
 
+#ifdef RTGUI_USING_TYPE_ANCESTORS
+#define DEFINE_CLASS_TYPE(type, name, parent, constructor, destructor, size) \
+	static struct rtgui_type_info _rtgui_##type##_info; \
+	const struct rtgui_type _rtgui_##type = { \
+	name, \
+	parent, \
+	RTGUI_CONSTRUCTOR(constructor), \
+	RTGUI_DESTRUCTOR(destructor), \
+	size, \
+	&_rtgui_##type##_info }; \
+	const rtgui_type_t *_rtgui_##type##_get_type(void) { return &_rtgui_##type; } \
+	RTM_EXPORT(_rtgui_##type##_get_type)
+#else
 #define DEFINE_CLASS_TYPE(type, name, parent, constructor, destructor, size) \
 	const struct rtgui_type _rtgui_##type = { \
 	name, \
@@ -72,6 +100,7 @@ typedef struct rtgui_type rtgui_type_t;
 	size }; \
 	const rtgui_type_t *_rtgui_##type##_get_type(void) { return &_rtgui_##type; } \
 	RTM_EXPORT(_rtgui_##type##_get_type)
+#endif
 
 void          rtgui_type_object_construct(const rtgui_type_t *type, rtgui_object_t *object);
 void          rtgui_type_destructors_call(const rtgui_type_t *type, rtgui_object_t *object);
@@ -120,6 +149,12 @@ struct rtgui_object
     enum rtgui_object_flag flag;
 
     rt_uint32_t id;
+#ifdef RTGUI_USING_ID_HASH
+    /* the application whose ID hash table has the object, and the next
+     * object in the same bucket */
+    struct rtgui_app *id_app;
+    struct rtgui_object *id_next;
+#endif
 };
 
 rtgui_object_t *rtgui_object_create(const rtgui_type_t *object_type);
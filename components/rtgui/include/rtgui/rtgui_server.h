@@ -16,6 +16,8 @@
 
 #include <rtservice.h>
 #include <rtgui/list.h>
+#include <rtgui/region.h>
+#include <rtgui/rtgui_system.h>
 
 /* RTGUI server definitions */
 
@@ -33,6 +35,10 @@ enum rtgui_topwin_flag
     WINTITLE_MODALING   = 0x100,
     WINTITLE_ONTOP      = 0x200,
     WINTITLE_ONBTM      = 0x400,
+    /* window pixels are kept in backing store */
+    WINTITLE_BACKING    = 0x800,
+    /* window has got the clip event of its current clip */
+    WINTITLE_CLIP_SYNCED = 0x1000,
 };
 
 struct rtgui_topwin
@@ -62,8 +68,55 @@ struct rtgui_topwin
 
     /* the monitor rect list */
     rtgui_list_t monitor_list;
+
+#ifdef RTGUI_USING_BACKING_STORE
+    /* the pixels of window in the extent, and the region of them which are
+     * up to date, relative to the extent */
+    struct rtgui_dc *backing;
+    rtgui_region_t backing_valid;
+#endif
+
+#ifdef RTGUI_USING_COMPOSITOR
+    /* the part of screen damage this window composes */
+    rtgui_region_t compose;
+#endif
+};
+
+/* statistics of window clip updates */
+struct rtgui_topwin_clip_stat
+{
+    /* clip events sent to windows, and the ones skipped as the clip of
+     * window is not changed */
+    rt_uint32_t sent;
+    rt_uint32_t skipped;
+};
+
+void rtgui_topwin_get_clip_stat(struct rtgui_topwin_clip_stat *stat);
+
+#ifdef RTGUI_USING_MOTION_COALESCE
+/* statistics of mouse motion events */
+struct rtgui_server_motion_stat
+{
+    /* motion samples received by server */
+    rt_uint32_t received;
+    /* samples merged into a later one of the same window */
+    rt_uint32_t merged;
+    /* events sent to applications, and the ones dropped as the event queue
+     * of application is full */
+    rt_uint32_t delivered;
+    rt_uint32_t dropped;
 };
 
+struct rtgui_event_mouse;
+
+void rtgui_server_get_motion_stat(struct rtgui_server_motion_stat *stat);
+/* get the positions merged into the motion event, the oldest one first. The
+ * samples out of the history are lost. Return the number of points */
+rt_size_t rtgui_server_get_motion_history(struct rtgui_event_mouse *event,
+                                          struct rtgui_point *points,
+                                          rt_size_t size);
+#endif
+
 /* top win manager init */
 void rtgui_topwin_init(void);
 void rtgui_server_init(void);
@@ -71,6 +124,29 @@ void rtgui_server_init(void);
 /* post an event to server */
 void rtgui_server_post_event(struct rtgui_event *event, rt_size_t size);
 rt_err_t rtgui_server_post_event_sync(struct rtgui_event *event, rt_size_t size);
+#ifdef RTGUI_USING_ASYNC_ACK
+rt_err_t rtgui_server_post_event_async(struct rtgui_event *event, rt_size_t size, rtgui_ack_t *ack);
+#endif
+
+#ifdef RTGUI_USING_UPDATE_DAMAGE
+/* statistics of screen update */
+struct rtgui_server_update_stat
+{
+    /* update rects submitted by applications and flushed to device in the
+     * last frame */
+    rt_uint32_t frame_submitted;
+    rt_uint32_t frame_flushed;
+
+    /* total of submitted rects, flushed rects and frames */
+    rt_uint32_t submitted;
+    rt_uint32_t flushed;
+    rt_uint32_t frames;
+};
+
+void rtgui_server_get_update_stat(struct rtgui_server_update_stat *stat);
+/* add rect of screen to the damage, flushed later in server */
+void rtgui_server_damage(rtgui_rect_t *rect);
+#endif
 
 #endif
 
@@ -83,8 +83,49 @@ rt_err_t rtgui_send(struct rtgui_app* app, struct rtgui_event *event, rt_size_t
 rt_err_t rtgui_send_urgent(struct rtgui_app* app, struct rtgui_event *event, rt_size_t event_size);
 rt_err_t rtgui_send_sync(struct rtgui_app* app, struct rtgui_event *event, rt_size_t event_size);
 rt_err_t rtgui_ack(struct rtgui_event *event, rt_int32_t status);
+#ifdef RTGUI_USING_ASYNC_ACK
+/* an acknowledgement channel of application */
+struct rtgui_ack_chan
+{
+    struct rt_mailbox mb;
+    rt_uint32_t buffer;
+    /* waiting for an ack */
+    rt_bool_t busy;
+};
+typedef struct rtgui_ack_chan *rtgui_ack_t;
+
+/* send the event and return the channel for the ack in @ack. It's -RT_EBUSY
+ * if the current application has no free channel. */
+rt_err_t rtgui_send_async(struct rtgui_app* app, struct rtgui_event *event, rt_size_t event_size,
+                          rtgui_ack_t *ack);
+/* wait for the ack and free the channel */
+rt_err_t rtgui_ack_wait(rtgui_ack_t ack);
+#endif
 rt_err_t rtgui_recv(struct rtgui_event *event, rt_size_t event_size);
 rt_err_t rtgui_recv_nosuspend(struct rtgui_event *event, rt_size_t event_size);
 rt_err_t rtgui_recv_filter(rt_uint32_t type, struct rtgui_event *event, rt_size_t event_size);
 
+#ifdef RTGUI_USING_EVENT_POOL
+/* statistics of event pool */
+struct rtgui_event_pool_stat
+{
+    /* the events allocated from pool and heap */
+    rt_uint32_t pooled;
+    rt_uint32_t heap;
+    /* the events not released yet */
+    rt_uint32_t used;
+};
+
+/* allocate an event of size bytes with one reference, or RT_NULL */
+struct rtgui_event *rtgui_event_alloc(rt_size_t size);
+void rtgui_event_ref(struct rtgui_event *event);
+/* the size the pooled event is allocated with */
+rt_size_t rtgui_event_get_size(struct rtgui_event *event);
+void rtgui_event_release(struct rtgui_event *event);
+/* send the pointer of a pooled event, the reference of caller is passed to
+ * application even if it fails */
+rt_err_t rtgui_send_pooled(struct rtgui_app *app, struct rtgui_event *event);
+void rtgui_event_get_pool_stat(struct rtgui_event_pool_stat *stat);
+#endif
+
 #endif
@@ -35,6 +35,11 @@ struct rtgui_label
 
     /* label */
     char *text;
+
+#ifdef RTGUI_USING_DC_RECORD
+    /* the recorded drawing of label */
+    struct rtgui_dc *record;
+#endif
 };
 typedef struct rtgui_label rtgui_label_t;
 
@@ -43,6 +43,8 @@ extern "C" {
 #define RTGUI_WIDGET_FLAG_FOCUSABLE     0x0010
 #define RTGUI_WIDGET_FLAG_DC_VISIBLE    0x0100
 #define RTGUI_WIDGET_FLAG_IN_ANIM       0x0200
+#define RTGUI_WIDGET_FLAG_CLIP_DIRTY    0x0400
+#define RTGUI_WIDGET_FLAG_PAINT_DIRTY   0x0800
 
 /* rtgui widget attribute */
 #define RTGUI_WIDGET_FOREGROUND(w)      (RTGUI_WIDGET(w)->gc.foreground)
@@ -119,6 +121,10 @@ struct rtgui_widget
     rt_uint16_t border_style;
     /* the rect clip */
     rtgui_region_t clip;
+#ifdef RTGUI_USING_LAZY_CLIP
+    /* the clip generation of window when the clip is computed */
+    rt_uint32_t clip_gen;
+#endif
 
     /* call back */
     rt_bool_t (*on_focus_in)(struct rtgui_object *widget, struct rtgui_event *event);
@@ -182,6 +188,10 @@ void rtgui_widget_move_to_logic(rtgui_widget_t *widget, int dx, int dy);
 
 /* update the clip info of widget */
 void rtgui_widget_update_clip(rtgui_widget_t *widget);
+#ifdef RTGUI_USING_LAZY_CLIP
+/* compute the clip of widget if it's out of date */
+void rtgui_widget_validate_clip(rtgui_widget_t *widget);
+#endif
 
 /* get the toplevel widget of widget */
 struct rtgui_win *rtgui_widget_get_toplevel(rtgui_widget_t *widget);
@@ -192,6 +202,16 @@ rt_bool_t rtgui_widget_onshow(struct rtgui_object *object, struct rtgui_event *e
 void rtgui_widget_hide(rtgui_widget_t *widget);
 rt_bool_t rtgui_widget_onhide(struct rtgui_object *object, struct rtgui_event *event);
 void rtgui_widget_update(rtgui_widget_t *widget);
+#ifdef RTGUI_USING_DEFERRED_PAINT
+/* paint the rect (logic, RT_NULL for whole widget) of widget later, with the
+ * other invalidated widgets of window in one pass */
+void rtgui_widget_invalidate(rtgui_widget_t *widget, rtgui_rect_t *rect);
+/* drop widget and its children from the widgets to paint of their window */
+void rtgui_widget_forget_dirty(rtgui_widget_t *widget);
+#else
+/* paint the widget now */
+#define rtgui_widget_invalidate(widget, rect)   rtgui_widget_update(widget)
+#endif
 
 /* get parent color */
 rtgui_color_t rtgui_widget_get_parent_foreground(rtgui_widget_t *widget);
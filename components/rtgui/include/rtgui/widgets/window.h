@@ -16,6 +16,7 @@
 #define __RTGUI_WINDOW_H__
 
 #include <rtgui/rtgui.h>
+#include <rtgui/rtgui_system.h>
 #include <rtgui/list.h>
 #include <rtgui/dc.h>
 #include <rtgui/widgets/widget.h>
@@ -39,6 +40,7 @@ DECLARE_CLASS_TYPE(win);
 #define RTGUI_WIN_STYLE_ONTOP               0x0040  /* window is in the top layer    */
 #define RTGUI_WIN_STYLE_ONBTM               0x0080  /* window is in the bottom layer */
 #define RTGUI_WIN_STYLE_MAINWIN             0x0106  /* window is a main window       */
+#define RTGUI_WIN_STYLE_BACKING_STORE       0x0200  /* server keeps the window pixels */
 
 #define RTGUI_WIN_STYLE_DEFAULT     (RTGUI_WIN_STYLE_CLOSEBOX | RTGUI_WIN_STYLE_MINIBOX)
 
@@ -82,6 +84,33 @@ struct rtgui_win
 
     struct rtgui_region outer_clip;
     struct rtgui_rect outer_extent;
+#ifdef RTGUI_USING_LAZY_CLIP
+    /* changed when outer_clip changes, the widget clips of other generations
+     * are out of date */
+    rt_uint32_t clip_gen;
+#endif
+
+#ifdef RTGUI_USING_DEFERRED_PAINT
+    /* the invalidated area of window and the widgets to paint in it */
+    rtgui_region_t dirty;
+    struct rtgui_widget *dirty_widgets[RTGUI_WIN_DIRTY_WIDGETS];
+    rt_uint16_t dirty_count;
+    /* the next window of application which has dirty widgets */
+    struct rtgui_win *dirty_next;
+#endif
+
+#ifdef RTGUI_USING_ASYNC_ACK
+    /* the acks of create and show requests not waited for yet */
+    rtgui_ack_t create_ack;
+    rtgui_ack_t show_ack;
+#endif
+
+#ifdef RTGUI_USING_COMPOSITOR
+    /* the surface over outer_extent the window draws to, set by server */
+    struct rtgui_graphic_driver *surface;
+    /* the opacity when server composes the window */
+    rt_uint8_t alpha;
+#endif
 
     /* the widget that will grab the focus in current window */
     struct rtgui_widget *focused_widget;
@@ -139,6 +168,15 @@ void rtgui_win_destroy(rtgui_win_t *win);
 rt_bool_t rtgui_win_close(struct rtgui_win *win);
 
 rt_base_t rtgui_win_show(struct rtgui_win *win, rt_bool_t is_modal);
+#ifdef RTGUI_USING_ASYNC_ACK
+/* create and show the window without waiting for server, so that several
+ * windows are built while server handles them. rtgui_win_wait() gets the
+ * result, the other window functions wait for it implicitly. */
+rtgui_win_t *rtgui_win_create_async(struct rtgui_win *parent_window, const char *title,
+                                    rtgui_rect_t *rect, rt_uint16_t style);
+rt_err_t rtgui_win_show_async(struct rtgui_win *win);
+rt_err_t rtgui_win_wait(struct rtgui_win *win);
+#endif
 void rtgui_win_hide(rtgui_win_t *win);
 void rtgui_win_end_modal(rtgui_win_t *win, rtgui_modal_code_t modal_code);
 rt_err_t rtgui_win_activate(struct rtgui_win *win);
@@ -149,6 +187,10 @@ void rtgui_win_move(struct rtgui_win *win, int x, int y);
 /* reset extent of window */
 void rtgui_win_set_rect(rtgui_win_t *win, rtgui_rect_t *rect);
 void rtgui_win_update_clip(struct rtgui_win *win);
+#ifdef RTGUI_USING_DEFERRED_PAINT
+/* paint the invalidated widgets of window, each once in the dirty region */
+void rtgui_win_paint_dirty(struct rtgui_win *win);
+#endif
 
 void rtgui_win_set_onactivate(rtgui_win_t *win, rtgui_event_handler_ptr handler);
 void rtgui_win_set_ondeactivate(rtgui_win_t *win, rtgui_event_handler_ptr handler);
@@ -164,5 +206,11 @@ char *rtgui_win_get_title(rtgui_win_t *win);
 
 struct rtgui_dc *rtgui_win_get_drawing(rtgui_win_t * win);
 
+#ifdef RTGUI_USING_COMPOSITOR
+/* set the opacity of window, 255 is opaque. Only the surfaces in RGB565 are
+ * blended, the others are composed as opaque */
+void rtgui_win_set_alpha(rtgui_win_t *win, rt_uint8_t alpha);
+#endif
+
 #endif
 
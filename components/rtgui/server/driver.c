@@ -132,9 +132,84 @@ rt_bool_t rtgui_graphic_driver_is_vmode(void)
 RTM_EXPORT(rtgui_graphic_driver_is_vmode);
 #endif
 
+#ifdef RTGUI_USING_COMPOSITOR
+#include <rtgui/rtgui_app.h>
+
+/*
+ * A surface is a driver of framebuffer ops over the pixels of a window. The
+ * framebuffer address is offset by the window position, so the drawing in
+ * screen coordinates goes to the right pixel of surface.
+ */
+struct rtgui_graphic_driver *rtgui_graphic_driver_surface_create(const struct rtgui_graphic_driver *driver,
+                                                                  rtgui_rect_t *rect)
+{
+    int pitch;
+    struct rtgui_graphic_driver *surface;
+
+    RT_ASSERT(driver != RT_NULL);
+    RT_ASSERT(rect != RT_NULL);
+
+    pitch = rtgui_rect_width(*rect) * _UI_BITBYTES(driver->bits_per_pixel);
+    surface = (struct rtgui_graphic_driver *)rtgui_malloc(sizeof(struct rtgui_graphic_driver) +
+                                                          pitch * rtgui_rect_height(*rect));
+    if (surface == RT_NULL)
+        return RT_NULL;
+
+    surface->pixel_format = driver->pixel_format;
+    surface->bits_per_pixel = driver->bits_per_pixel;
+    surface->pitch = pitch;
+    surface->width = rtgui_rect_width(*rect);
+    surface->height = rtgui_rect_height(*rect);
+    surface->device = RT_NULL;
+    surface->ops = rtgui_framebuffer_get_ops(driver->pixel_format);
+    surface->ext_ops = RT_NULL;
+    if (surface->ops == RT_NULL)
+    {
+        rtgui_free(surface);
+        return RT_NULL;
+    }
+
+    rt_memset(surface + 1, 0, pitch * surface->height);
+    rtgui_graphic_driver_surface_moveto(surface, rect->x1, rect->y1);
+
+    return surface;
+}
+RTM_EXPORT(rtgui_graphic_driver_surface_create);
+
+void rtgui_graphic_driver_surface_destroy(struct rtgui_graphic_driver *surface)
+{
+    rtgui_free(surface);
+}
+RTM_EXPORT(rtgui_graphic_driver_surface_destroy);
+
+void rtgui_graphic_driver_surface_moveto(struct rtgui_graphic_driver *surface, int x, int y)
+{
+    surface->framebuffer = (rt_uint8_t *)(surface + 1) - y * surface->pitch -
+                           x * _UI_BITBYTES(surface->bits_per_pixel);
+}
+RTM_EXPORT(rtgui_graphic_driver_surface_moveto);
+
+rt_uint8_t *rtgui_graphic_driver_surface_pixel(const struct rtgui_graphic_driver *surface)
+{
+    return (rt_uint8_t *)(surface + 1);
+}
+RTM_EXPORT(rtgui_graphic_driver_surface_pixel);
+#endif
+
 /* get default driver */
 struct rtgui_graphic_driver *rtgui_graphic_driver_get_default(void)
 {
+#ifdef RTGUI_USING_COMPOSITOR
+    /* the application is drawing a window, use the surface of window */
+    if (_current_driver == &_driver)
+    {
+        struct rtgui_app *app = rtgui_app_self();
+
+        if (app != RT_NULL && app->surface != RT_NULL)
+            return app->surface;
+    }
+#endif
+
     return _current_driver;
 }
 RTM_EXPORT(rtgui_graphic_driver_get_default);
@@ -221,9 +296,21 @@ rt_err_t rtgui_graphic_set_device(rt_device_t device)
 }
 RTM_EXPORT(rtgui_graphic_set_device);
 
+void rtgui_graphic_driver_flush(const struct rtgui_graphic_driver *driver)
+{
+#ifdef RTGUI_USING_PIXEL_BATCH
+	/* the pixel device ops batch the writes */
+	if (driver->framebuffer == RT_NULL && driver->device != RT_NULL)
+		rtgui_pixel_device_flush();
+#endif
+}
+RTM_EXPORT(rtgui_graphic_driver_flush);
+
 /* screen update */
 void rtgui_graphic_driver_screen_update(const struct rtgui_graphic_driver *driver, rtgui_rect_t *rect)
 {
+	rtgui_graphic_driver_flush(driver);
+
 	if (driver->device != RT_NULL)
 	{
 	    struct rt_device_rect_info rect_info;
@@ -278,3 +365,15 @@ void rtgui_cursor_set_image(enum rtgui_cursor_type type)
 };
 #endif
 
+#if defined(RTGUI_USING_PIXEL_BATCH) && defined(RT_USING_FINSH)
+#include <finsh.h>
+void list_pixel_batch(void)
+{
+    struct rtgui_pixel_batch_stat stat;
+
+    rtgui_pixel_device_get_stat(&stat);
+    rt_kprintf("pixel device: %d writes, %d device calls, %d saved\n",
+               stat.writes, stat.calls, stat.writes - stat.calls);
+}
+FINSH_FUNCTION_EXPORT(list_pixel_batch, display pixel device batching statistics);
+#endif
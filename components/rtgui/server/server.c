@@ -18,6 +18,7 @@
 #include <rtgui/rtgui_object.h>
 #include <rtgui/rtgui_app.h>
 #include <rtgui/driver.h>
+#include <rtgui/region.h>
 #include <rtgui/touch.h>
 
 #include <rtgui/widgets/window.h>
@@ -30,6 +31,88 @@ static struct rtgui_app *rtgui_server_app = RT_NULL;
 static struct rtgui_app *rtgui_wm_application = RT_NULL;
 static struct rtgui_topwin *last_monitor_topwin = RT_NULL;
 
+#if defined(RTGUI_USING_UPDATE_DAMAGE) || defined(RTGUI_USING_MOTION_COALESCE)
+static void rtgui_server_onidle(struct rtgui_object *object, struct rtgui_event *event);
+#endif
+
+#ifdef RTGUI_USING_UPDATE_DAMAGE
+/* the screen damage which is not flushed to device yet */
+static rtgui_region_t _update_damage;
+static rt_tick_t _update_damage_tick;
+static rt_uint32_t _update_submitted;
+static struct rtgui_server_update_stat _update_stat;
+
+static void rtgui_server_flush_update(void)
+{
+    int index, count;
+    rtgui_rect_t *rects;
+    struct rtgui_graphic_driver *driver;
+
+    if (!rtgui_region_not_empty(&_update_damage))
+        return;
+
+    driver = rtgui_graphic_driver_get_default();
+    if (driver != RT_NULL)
+    {
+#ifdef RTGUI_USING_COMPOSITOR
+        /* compose the damaged region from window surfaces firstly */
+        rtgui_topwin_compose(&_update_damage);
+#endif
+        count = rtgui_region_num_rects(&_update_damage);
+        if (count > RTGUI_UPDATE_DAMAGE_MAX_RECTS)
+        {
+            /* too fragmented, update the extents in one shot */
+            count = 1;
+            rects = rtgui_region_extents(&_update_damage);
+        }
+        else
+        {
+            rects = rtgui_region_rects(&_update_damage);
+        }
+
+        for (index = 0; index < count; index ++)
+            rtgui_graphic_driver_screen_update(driver, &rects[index]);
+
+        _update_stat.frame_submitted = _update_submitted;
+        _update_stat.frame_flushed = count;
+        _update_stat.flushed += count;
+        _update_stat.frames ++;
+    }
+
+    _update_submitted = 0;
+    rtgui_region_empty(&_update_damage);
+}
+
+void rtgui_server_damage(rtgui_rect_t *rect)
+{
+    if (!rtgui_region_not_empty(&_update_damage))
+        _update_damage_tick = rt_tick_get();
+
+    rtgui_region_union_rect(&_update_damage, &_update_damage, rect);
+
+    /* the event queue is busy for a whole frame, flush it now */
+    if (rt_tick_get() - _update_damage_tick >= RTGUI_UPDATE_FRAME_TICKS)
+        rtgui_server_flush_update();
+    else
+        rtgui_app_set_onidle(rtgui_server_app, rtgui_server_onidle);
+}
+
+void rtgui_server_handle_update(struct rtgui_event_update_end *event)
+{
+    _update_submitted ++;
+    _update_stat.submitted ++;
+
+    rtgui_server_damage(&(event->rect));
+}
+
+void rtgui_server_get_update_stat(struct rtgui_server_update_stat *stat)
+{
+    RT_ASSERT(stat != RT_NULL);
+
+    *stat = _update_stat;
+}
+RTM_EXPORT(rtgui_server_get_update_stat);
+#else
 void rtgui_server_handle_update(struct rtgui_event_update_end *event)
 {
     struct rtgui_graphic_driver *driver;
@@ -40,6 +123,120 @@ void rtgui_server_handle_update(struct rtgui_event_update_end *event)
         rtgui_graphic_driver_screen_update(driver, &(event->rect));
     }
 }
+#endif
+
+#ifdef RTGUI_USING_MOTION_COALESCE
+/* the motion event not sent yet and its application */
+static struct rtgui_event_mouse _motion_pending;
+static struct rtgui_app *_motion_pending_app = RT_NULL;
+static rt_tick_t _motion_pending_tick;
+/* the cursor is moved with the pending motion */
+static rt_bool_t _motion_cursor_moved = RT_FALSE;
+static rt_uint16_t _motion_cursor_x, _motion_cursor_y;
+static struct rtgui_server_motion_stat _motion_stat;
+
+/* the positions of the last samples, indexed by sequence number */
+static struct rtgui_point _motion_history[RTGUI_MOTION_HISTORY_SIZE];
+static rt_uint32_t _motion_seq = 0;
+
+static void rtgui_server_flush_motion(void)
+{
+    if (_motion_pending_app != RT_NULL)
+    {
+        if (rtgui_send(_motion_pending_app, &(_motion_pending.parent),
+                       sizeof(struct rtgui_event_mouse)) == RT_EOK)
+            _motion_stat.delivered ++;
+        else
+            _motion_stat.dropped ++;
+
+        _motion_pending_app = RT_NULL;
+    }
+
+    if (_motion_cursor_moved == RT_TRUE)
+    {
+        /* move mouse to the latest (x, y) */
+        rtgui_mouse_moveto(_motion_cursor_x, _motion_cursor_y);
+        _motion_cursor_moved = RT_FALSE;
+    }
+}
+
+static void rtgui_server_queue_motion(struct rtgui_topwin *topwin,
+                                      struct rtgui_event_mouse *event)
+{
+    if (_motion_pending_app != RT_NULL)
+    {
+        if (_motion_pending.wid == topwin->wid)
+        {
+            /* replace the pending one of the same window */
+            event->merged = _motion_pending.merged + 1;
+            _motion_stat.merged ++;
+        }
+        else
+        {
+            rtgui_server_flush_motion();
+        }
+    }
+
+    if (_motion_pending_app == RT_NULL)
+        event->merged = 0;
+
+    event->wid = topwin->wid;
+    _motion_pending = *event;
+    _motion_pending_app = topwin->app;
+}
+
+void rtgui_server_get_motion_stat(struct rtgui_server_motion_stat *stat)
+{
+    RT_ASSERT(stat != RT_NULL);
+
+    *stat = _motion_stat;
+}
+RTM_EXPORT(rtgui_server_get_motion_stat);
+
+rt_size_t rtgui_server_get_motion_history(struct rtgui_event_mouse *event,
+                                          struct rtgui_point *points,
+                                          rt_size_t size)
+{
+    rt_uint32_t seq;
+    rt_size_t count;
+
+    RT_ASSERT(event != RT_NULL);
+    RT_ASSERT(points != RT_NULL);
+
+    count = event->merged + 1;
+    if (count > size)
+        count = size;
+
+    /* the server thread records the samples in critical section too */
+    rt_enter_critical();
+    /* the samples before _motion_seq - RTGUI_MOTION_HISTORY_SIZE are lost */
+    if (event->seq + RTGUI_MOTION_HISTORY_SIZE <= _motion_seq)
+        count = 0;
+    else if (count > event->seq + RTGUI_MOTION_HISTORY_SIZE - _motion_seq)
+        count = event->seq + RTGUI_MOTION_HISTORY_SIZE - _motion_seq;
+    for (seq = event->seq + 1 - count; seq <= event->seq; seq ++)
+        *points++ = _motion_history[seq % RTGUI_MOTION_HISTORY_SIZE];
+    rt_exit_critical();
+
+    return count;
+}
+RTM_EXPORT(rtgui_server_get_motion_history);
+#endif
+
+#if defined(RTGUI_USING_UPDATE_DAMAGE) || defined(RTGUI_USING_MOTION_COALESCE)
+static void rtgui_server_onidle(struct rtgui_object *object, struct rtgui_event *event)
+{
+#ifdef RTGUI_USING_MOTION_COALESCE
+    rtgui_server_flush_motion();
+#endif
+#ifdef RTGUI_USING_UPDATE_DAMAGE
+    rtgui_server_flush_update();
+#endif
+
+    /* suspend on the event queue again */
+    rtgui_app_set_onidle(rtgui_server_app, RT_NULL);
+}
+#endif
 
 void rtgui_server_handle_monitor_add(struct rtgui_event_monitor *event)
 {
@@ -57,6 +254,11 @@ void rtgui_server_handle_mouse_btn(struct rtgui_event_mouse *event)
 {
     struct rtgui_topwin *wnd;
 
+#ifdef RTGUI_USING_MOTION_COALESCE
+    /* the motion before button comes first */
+    rtgui_server_flush_motion();
+#endif
+
     /* re-init to server thread */
     RTGUI_EVENT_MOUSE_BUTTON_INIT(event);
 
@@ -120,18 +322,55 @@ void rtgui_server_handle_mouse_motion(struct rtgui_event_mouse *event)
     /* re-init mouse event */
     RTGUI_EVENT_MOUSE_MOTION_INIT(event);
 
+#ifdef RTGUI_USING_MOTION_COALESCE
+    _motion_stat.received ++;
+
+    rt_enter_critical();
+    _motion_seq ++;
+    _motion_history[_motion_seq % RTGUI_MOTION_HISTORY_SIZE].x = event->x;
+    _motion_history[_motion_seq % RTGUI_MOTION_HISTORY_SIZE].y = event->y;
+    rt_exit_critical();
+    event->seq = _motion_seq;
+
+    if (_motion_pending_app == RT_NULL && _motion_cursor_moved == RT_FALSE)
+        _motion_pending_tick = rt_tick_get();
+#endif
+
     win = rtgui_topwin_get_wnd_no_modaled(event->x, event->y);
     if (win != RT_NULL && win->monitor_list.next != RT_NULL)
     {
         // FIXME:
         /* check whether the monitor exist */
-        if (rtgui_mouse_monitor_contains_point(&(win->monitor_list),
-                                               event->x, event->y) != RT_TRUE)
+        if (rtgui_topwin_monitor_contains_point(win, event->x, event->y) != RT_TRUE)
         {
             win = RT_NULL;
         }
     }
 
+#ifdef RTGUI_USING_MOTION_COALESCE
+    if (last_monitor_topwin != RT_NULL)
+        rtgui_server_queue_motion(last_monitor_topwin, event);
+
+    if (last_monitor_topwin != win)
+    {
+        /* the last window gets the position leaving it */
+        rtgui_server_flush_motion();
+
+        last_monitor_topwin = win;
+        if (last_monitor_topwin != RT_NULL)
+            rtgui_server_queue_motion(last_monitor_topwin, event);
+    }
+
+    _motion_cursor_x = event->x;
+    _motion_cursor_y = event->y;
+    _motion_cursor_moved = RT_TRUE;
+
+    /* the event queue is busy for long, send it now */
+    if (rt_tick_get() - _motion_pending_tick >= RTGUI_MOTION_COALESCE_TICKS)
+        rtgui_server_flush_motion();
+    else
+        rtgui_app_set_onidle(rtgui_server_app, rtgui_server_onidle);
+#else
     if (last_monitor_topwin != RT_NULL)
     {
         event->wid = last_monitor_topwin->wid;
@@ -157,6 +396,7 @@ void rtgui_server_handle_mouse_motion(struct rtgui_event_mouse *event)
 
     /* move mouse to (x, y) */
     rtgui_mouse_moveto(event->x, event->y);
+#endif
 }
 
 void rtgui_server_handle_kbd(struct rtgui_event_kbd *event)
@@ -225,6 +465,16 @@ static rt_bool_t rtgui_server_event_handler(struct rtgui_object *object,
     RT_ASSERT(object != RT_NULL);
     RT_ASSERT(event != RT_NULL);
 
+#ifdef RTGUI_USING_MOTION_COALESCE
+    /* send the pending motion before other input and window events to keep
+     * the order, and before its window goes away */
+    if (event->type != RTGUI_EVENT_MOUSE_MOTION &&
+        event->type != RTGUI_EVENT_TOUCH &&
+        event->type != RTGUI_EVENT_UPDATE_BEGIN &&
+        event->type != RTGUI_EVENT_UPDATE_END)
+        rtgui_server_flush_motion();
+#endif
+
     /* dispatch event */
     switch (event->type)
     {
@@ -319,6 +569,9 @@ static rt_bool_t rtgui_server_event_handler(struct rtgui_object *object,
     case RTGUI_EVENT_WIN_RESIZE:
         rtgui_topwin_resize(((struct rtgui_event_win_resize *)event)->wid,
                             &(((struct rtgui_event_win_resize *)event)->rect));
+        /* the resize is synchronous when the window surface is replaced */
+        if (event->ack != RT_NULL)
+            rtgui_ack(event, RTGUI_STATUS_OK);
         break;
 
     case RTGUI_EVENT_SET_WM:
@@ -341,16 +594,21 @@ static rt_bool_t rtgui_server_event_handler(struct rtgui_object *object,
         break;
 
     case RTGUI_EVENT_UPDATE_BEGIN:
-#ifdef RTGUI_USING_MOUSE_CURSOR
+#if defined(RTGUI_USING_MOUSE_CURSOR) && !defined(RTGUI_USING_COMPOSITOR)
         /* hide cursor */
         rtgui_mouse_hide_cursor();
 #endif
         break;
 
     case RTGUI_EVENT_UPDATE_END:
+#ifdef RTGUI_USING_BACKING_STORE
+        /* keep the drawing in backing store */
+        rtgui_topwin_backing_save(((struct rtgui_event_update_end *)event)->wid,
+                                  &(((struct rtgui_event_update_end *)event)->rect));
+#endif
         /* handle screen update */
         rtgui_server_handle_update((struct rtgui_event_update_end *)event);
-#ifdef RTGUI_USING_MOUSE_CURSOR
+#if defined(RTGUI_USING_MOUSE_CURSOR) && !defined(RTGUI_USING_COMPOSITOR)
         /* show cursor */
         rtgui_mouse_show_cursor();
 #endif
@@ -390,6 +648,9 @@ static void rtgui_server_entry(void *parameter)
 
     rtgui_object_set_event_handler(RTGUI_OBJECT(rtgui_server_app),
                                    rtgui_server_event_handler);
+#ifdef RTGUI_USING_UPDATE_DAMAGE
+    rtgui_region_init(&_update_damage);
+#endif
     /* init mouse and show */
     rtgui_mouse_init();
 #ifdef RTGUI_USING_MOUSE_CURSOR
@@ -398,6 +659,9 @@ static void rtgui_server_entry(void *parameter)
 
     rtgui_app_run(rtgui_server_app);
 
+#ifdef RTGUI_USING_UPDATE_DAMAGE
+    rtgui_region_fini(&_update_damage);
+#endif
     rtgui_app_destroy(rtgui_server_app);
     rtgui_server_app = RT_NULL;
 }
@@ -421,6 +685,19 @@ rt_err_t rtgui_server_post_event_sync(struct rtgui_event *event, rt_size_t size)
     }
 }
 
+#ifdef RTGUI_USING_ASYNC_ACK
+rt_err_t rtgui_server_post_event_async(struct rtgui_event *event, rt_size_t size, rtgui_ack_t *ack)
+{
+    if (rtgui_server_app != RT_NULL)
+        return rtgui_send_async(rtgui_server_app, event, size, ack);
+    else
+    {
+        rt_kprintf("post when server is not running\n");
+        return -RT_ENOSYS;
+    }
+}
+#endif
+
 struct rtgui_app* rtgui_get_server(void)
 {
     rt_thread_t tid = rt_thread_find("rtgui");
@@ -446,3 +723,26 @@ void rtgui_server_init(void)
         rt_thread_startup(tid);
 }
 
+
+#if defined(RTGUI_USING_UPDATE_DAMAGE) && defined(RT_USING_FINSH)
+#include <finsh.h>
+void list_update(void)
+{
+    rt_kprintf("last frame: %d rects submitted, %d flushed\n",
+               _update_stat.frame_submitted, _update_stat.frame_flushed);
+    rt_kprintf("total: %d rects submitted, %d flushed in %d frames\n",
+               _update_stat.submitted, _update_stat.flushed, _update_stat.frames);
+}
+FINSH_FUNCTION_EXPORT(list_update, display screen update statistics);
+#endif
+
+#if defined(RTGUI_USING_MOTION_COALESCE) && defined(RT_USING_FINSH)
+#include <finsh.h>
+void list_motion(void)
+{
+    rt_kprintf("motion: %d received, %d merged, %d delivered, %d dropped\n",
+               _motion_stat.received, _motion_stat.merged,
+               _motion_stat.delivered, _motion_stat.dropped);
+}
+FINSH_FUNCTION_EXPORT(list_motion, display mouse motion statistics);
+#endif
@@ -56,8 +56,394 @@ static rt_list_t _rtgui_topwin_list = RT_LIST_OBJECT_INIT(_rtgui_topwin_list);
 
 static void rtgui_topwin_update_clip(void);
 static void rtgui_topwin_redraw(struct rtgui_rect *rect);
+static struct rtgui_topwin_clip_stat _clip_stat;
 static void _rtgui_topwin_activate_next(enum rtgui_topwin_flag);
 
+#ifdef RTGUI_USING_TOPWIN_GRID
+/* the hit grid is rebuilt on next lookup */
+static rt_bool_t _hit_grid_valid;
+#define _rtgui_topwin_grid_invalidate()     (_hit_grid_valid = RT_FALSE)
+#else
+#define _rtgui_topwin_grid_invalidate()
+#endif
+
+#ifdef RTGUI_USING_BACKING_STORE
+#include <rtgui/dc.h>
+#include <rtgui/driver.h>
+
+/*
+ * The backing store of a window is a buffer DC in the pixel format of
+ * framebuffer, over the extent of topwin. At each update end, the visible part
+ * of the drawing is copied from framebuffer to the backing store, and the part
+ * covered by other windows is marked out of date. When the window is exposed
+ * and the exposed area is up to date in backing store, the server copies it
+ * back to framebuffer and the window does not get the paint event.
+ */
+
+/* bytes of the backing buffers */
+static rt_uint32_t _backing_used;
+
+static struct rtgui_topwin *rtgui_topwin_search_in_list(struct rtgui_win *window,
+        struct rt_list_node *list);
+
+static void _rtgui_topwin_backing_free(struct rtgui_topwin *topwin)
+{
+    if (topwin->backing != RT_NULL)
+    {
+        struct rtgui_dc_buffer *buffer = (struct rtgui_dc_buffer *)topwin->backing;
+
+        _backing_used -= buffer->pitch * buffer->height;
+        rtgui_dc_destory(topwin->backing);
+        topwin->backing = RT_NULL;
+    }
+    rtgui_region_empty(&topwin->backing_valid);
+}
+
+/* get the backing buffer of topwin, create it when it fits in the budget */
+static struct rtgui_dc_buffer *_rtgui_topwin_backing_get(struct rtgui_topwin *topwin,
+                                                          struct rtgui_graphic_driver *driver)
+{
+    int w, h;
+    rt_uint32_t size;
+    struct rtgui_dc_buffer *buffer;
+
+    if (!(topwin->flag & WINTITLE_BACKING) || driver->framebuffer == RT_NULL)
+        return RT_NULL;
+
+    w = rtgui_rect_width(topwin->extent);
+    h = rtgui_rect_height(topwin->extent);
+    buffer = (struct rtgui_dc_buffer *)topwin->backing;
+    if (buffer != RT_NULL)
+    {
+        if (buffer->width == w && buffer->height == h &&
+            buffer->pixel_format == driver->pixel_format)
+            return buffer;
+
+        /* the window is resized */
+        _rtgui_topwin_backing_free(topwin);
+    }
+
+    size = w * rtgui_color_get_bpp(driver->pixel_format) * h;
+    if (w <= 0 || h <= 0 || _backing_used + size > RTGUI_BACKING_STORE_BUDGET)
+        return RT_NULL;
+
+    topwin->backing = rtgui_dc_buffer_create_pixformat(driver->pixel_format, w, h);
+    if (topwin->backing == RT_NULL)
+        return RT_NULL;
+    _backing_used += size;
+
+    return (struct rtgui_dc_buffer *)topwin->backing;
+}
+
+/* copy the region (in screen) between framebuffer and backing buffer */
+static void _rtgui_topwin_backing_copy(struct rtgui_topwin *topwin,
+                                       struct rtgui_dc_buffer *buffer,
+                                       struct rtgui_graphic_driver *driver,
+                                       rtgui_region_t *region, rt_bool_t save)
+{
+    int index, count, bpp, len, y;
+    rtgui_rect_t *rects;
+    rt_uint8_t *screen, *pixel;
+
+    bpp = rtgui_color_get_bpp(driver->pixel_format);
+    count = rtgui_region_num_rects(region);
+    rects = rtgui_region_rects(region);
+
+#ifdef RTGUI_USING_MOUSE_CURSOR
+    rtgui_mouse_hide_cursor();
+#endif
+    for (index = 0; index < count; index ++)
+    {
+        len = rtgui_rect_width(rects[index]) * bpp;
+        screen = driver->framebuffer + rects[index].y1 * driver->pitch + rects[index].x1 * bpp;
+        pixel = buffer->pixel + (rects[index].y1 - topwin->extent.y1) * buffer->pitch +
+                (rects[index].x1 - topwin->extent.x1) * bpp;
+
+        for (y = rects[index].y1; y < rects[index].y2; y ++)
+        {
+            if (save)
+                rt_memcpy(pixel, screen, len);
+            else
+                rt_memcpy(screen, pixel, len);
+
+            screen += driver->pitch;
+            pixel  += buffer->pitch;
+        }
+    }
+#ifdef RTGUI_USING_MOUSE_CURSOR
+    rtgui_mouse_show_cursor();
+#endif
+}
+
+void rtgui_topwin_backing_save(struct rtgui_win *wid, rtgui_rect_t *rect)
+{
+    struct rtgui_topwin *topwin;
+    struct rtgui_dc_buffer *buffer;
+    struct rtgui_graphic_driver *driver;
+    rtgui_region_t drawn, visible;
+
+    topwin = rtgui_topwin_search_in_list(wid, &_rtgui_topwin_list);
+    if (topwin == RT_NULL || !(topwin->flag & WINTITLE_SHOWN))
+        return;
+
+    driver = rtgui_graphic_driver_get_default();
+    rtgui_screen_lock(RT_WAITING_FOREVER);
+
+    buffer = _rtgui_topwin_backing_get(topwin, driver);
+    if (buffer != RT_NULL)
+    {
+        rtgui_region_init_with_extents(&drawn, rect);
+        rtgui_region_intersect_rect(&drawn, &drawn, &topwin->extent);
+        rtgui_region_init(&visible);
+        rtgui_region_intersect(&visible, &drawn, &wid->outer_clip);
+
+        _rtgui_topwin_backing_copy(topwin, buffer, driver, &visible, RT_TRUE);
+
+        /* the drawing under other windows is not in framebuffer */
+        rtgui_region_subtract(&drawn, &drawn, &visible);
+        rtgui_region_translate(&drawn, -topwin->extent.x1, -topwin->extent.y1);
+        rtgui_region_translate(&visible, -topwin->extent.x1, -topwin->extent.y1);
+        rtgui_region_subtract(&topwin->backing_valid, &topwin->backing_valid, &drawn);
+        rtgui_region_union(&topwin->backing_valid, &topwin->backing_valid, &visible);
+
+        rtgui_region_fini(&drawn);
+        rtgui_region_fini(&visible);
+    }
+
+    rtgui_screen_unlock();
+}
+
+/* restore the exposed part of topwin in rect from backing store. Return
+ * RT_FALSE when it is not up to date and the window should paint itself. */
+static rt_bool_t _rtgui_topwin_backing_restore(struct rtgui_topwin *topwin, struct rtgui_rect *rect)
+{
+    rt_bool_t result;
+    struct rtgui_graphic_driver *driver;
+    rtgui_region_t exposed, stale;
+
+    if (topwin->backing == RT_NULL)
+        return RT_FALSE;
+
+    driver = rtgui_graphic_driver_get_default();
+    rtgui_screen_lock(RT_WAITING_FOREVER);
+    if (_rtgui_topwin_backing_get(topwin, driver) == RT_NULL)
+    {
+        rtgui_screen_unlock();
+        return RT_FALSE;
+    }
+
+    rtgui_region_init_with_extents(&exposed, rect);
+    rtgui_region_intersect_rect(&exposed, &exposed, &topwin->extent);
+    rtgui_region_intersect(&exposed, &exposed, &topwin->wid->outer_clip);
+
+    rtgui_region_init(&stale);
+    rtgui_region_copy(&stale, &topwin->backing_valid);
+    rtgui_region_translate(&stale, topwin->extent.x1, topwin->extent.y1);
+    rtgui_region_subtract(&stale, &exposed, &stale);
+
+    result = rtgui_region_not_empty(&stale) ? RT_FALSE : RT_TRUE;
+    if (result == RT_TRUE && rtgui_region_not_empty(&exposed))
+    {
+        _rtgui_topwin_backing_copy(topwin, (struct rtgui_dc_buffer *)topwin->backing,
+                                   driver, &exposed, RT_FALSE);
+        rtgui_graphic_driver_screen_update(driver, rtgui_region_extents(&exposed));
+    }
+    rtgui_screen_unlock();
+
+    rtgui_region_fini(&exposed);
+    rtgui_region_fini(&stale);
+
+    return result;
+}
+#endif
+
+#ifdef RTGUI_USING_COMPOSITOR
+#include <rtgui/driver.h>
+#include <rtgui/blit.h>
+
+/*
+ * Each shown window draws to a surface over its extent. The damage of screen
+ * is composed in two passes: from top to bottom, each window takes the part of
+ * damage not covered by the opaque windows above it. Then from bottom to top,
+ * each window copies or blends its part from surface to screen. The damage left
+ * uncovered is filled with background.
+ */
+
+/* make the surface of window fit the extent, the pixels are lost if the size
+ * changes */
+static void _rtgui_topwin_surface_update(struct rtgui_topwin *topwin)
+{
+    struct rtgui_graphic_driver *surface;
+
+    surface = topwin->wid->surface;
+    if (surface != RT_NULL &&
+        (surface->width != rtgui_rect_width(topwin->extent) ||
+         surface->height != rtgui_rect_height(topwin->extent)))
+    {
+        rtgui_graphic_driver_surface_destroy(surface);
+        surface = RT_NULL;
+    }
+
+    if (surface == RT_NULL)
+        surface = rtgui_graphic_driver_surface_create(rtgui_graphic_driver_get_default(),
+                                                      &topwin->extent);
+    else
+        rtgui_graphic_driver_surface_moveto(surface, topwin->extent.x1, topwin->extent.y1);
+
+    /* without surface, the window could not draw itself */
+    topwin->wid->surface = surface;
+}
+
+static void _rtgui_topwin_surface_free(struct rtgui_topwin *topwin)
+{
+    if (topwin->wid->surface != RT_NULL)
+    {
+        rtgui_graphic_driver_surface_destroy(topwin->wid->surface);
+        topwin->wid->surface = RT_NULL;
+    }
+}
+
+/* the window hides the ones below it */
+rt_inline rt_bool_t _rtgui_topwin_is_opaque(struct rtgui_topwin *topwin,
+                                            struct rtgui_graphic_driver *driver)
+{
+    return topwin->wid->alpha == 255 || driver->framebuffer == RT_NULL ||
+           driver->pixel_format != RTGRAPHIC_PIXEL_FORMAT_RGB565;
+}
+
+/* from top to bottom, take the part of region for each window */
+static void _rtgui_topwin_compose_clip(struct rt_list_node *list, rtgui_region_t *region,
+                                       struct rtgui_graphic_driver *driver)
+{
+    struct rt_list_node *node;
+    struct rtgui_topwin *topwin;
+
+    rt_list_foreach(node, list, next)
+    {
+        topwin = get_topwin_from_list(node);
+        if (!(topwin->flag & WINTITLE_SHOWN))
+            continue;
+
+        /* the children are above the parent */
+        _rtgui_topwin_compose_clip(&topwin->child_list, region, driver);
+
+        if (topwin->wid->surface == RT_NULL)
+        {
+            rtgui_region_empty(&topwin->compose);
+            continue;
+        }
+
+        rtgui_region_intersect_rect(&topwin->compose, region, &topwin->extent);
+        if (_rtgui_topwin_is_opaque(topwin, driver))
+            rtgui_region_subtract_rect(region, region, &topwin->extent);
+    }
+}
+
+static void _rtgui_topwin_compose_surface(struct rtgui_topwin *topwin,
+                                          struct rtgui_graphic_driver *driver)
+{
+    int index, count, bpp, y;
+    rtgui_rect_t *rects;
+    struct rtgui_graphic_driver *surface;
+
+    surface = topwin->wid->surface;
+    bpp = _UI_BITBYTES(driver->bits_per_pixel);
+    count = rtgui_region_num_rects(&topwin->compose);
+    rects = rtgui_region_rects(&topwin->compose);
+
+    for (index = 0; index < count; index ++)
+    {
+        rtgui_rect_t *rect = &rects[index];
+        rt_uint8_t *src = surface->framebuffer + rect->y1 * surface->pitch + rect->x1 * bpp;
+
+        if (!_rtgui_topwin_is_opaque(topwin, driver))
+        {
+            struct rtgui_blit_info info;
+
+            info.a         = topwin->wid->alpha;
+            info.src       = src;
+            info.src_fmt   = surface->pixel_format;
+            info.src_w     = rtgui_rect_width(*rect);
+            info.src_h     = rtgui_rect_height(*rect);
+            info.src_pitch = surface->pitch;
+            info.src_skip  = info.src_pitch - info.src_w * bpp;
+
+            info.dst       = driver->framebuffer + rect->y1 * driver->pitch + rect->x1 * bpp;
+            info.dst_fmt   = driver->pixel_format;
+            info.dst_w     = info.src_w;
+            info.dst_h     = info.src_h;
+            info.dst_pitch = driver->pitch;
+            info.dst_skip  = info.dst_pitch - info.dst_w * bpp;
+
+            rtgui_blit(&info);
+            continue;
+        }
+
+        for (y = rect->y1; y < rect->y2; y ++)
+        {
+            driver->ops->draw_raw_hline(src, rect->x1, rect->x2, y);
+            src += surface->pitch;
+        }
+    }
+}
+
+/* from bottom to top, draw the part of each window */
+static void _rtgui_topwin_compose_draw(struct rt_list_node *list,
+                                       struct rtgui_graphic_driver *driver)
+{
+    struct rt_list_node *node;
+    struct rtgui_topwin *topwin;
+
+    rt_list_foreach(node, list, prev)
+    {
+        topwin = get_topwin_from_list(node);
+        if (!(topwin->flag & WINTITLE_SHOWN))
+            continue;
+
+        if (topwin->wid->surface != RT_NULL)
+            _rtgui_topwin_compose_surface(topwin, driver);
+
+        _rtgui_topwin_compose_draw(&topwin->child_list, driver);
+    }
+}
+
+void rtgui_topwin_compose(rtgui_region_t *damage)
+{
+    int index, count;
+    rtgui_rect_t rect, *rects;
+    rtgui_region_t region;
+    rtgui_color_t background = RTGUI_COMPOSITOR_BACKGROUND;
+    struct rtgui_graphic_driver *driver;
+
+    driver = rtgui_graphic_driver_get_default();
+    rtgui_graphic_driver_get_rect(driver, &rect);
+    rtgui_region_init(&region);
+    rtgui_region_intersect_rect(&region, damage, &rect);
+
+    _rtgui_topwin_compose_clip(&_rtgui_topwin_list, &region, driver);
+
+    rtgui_screen_lock(RT_WAITING_FOREVER);
+#ifdef RTGUI_USING_MOUSE_CURSOR
+    rtgui_mouse_hide_cursor();
+#endif
+
+    /* the damage which no window covers */
+    count = rtgui_region_num_rects(&region);
+    rects = rtgui_region_rects(&region);
+    for (index = 0; index < count; index ++)
+        rtgui_graphic_driver_fill_rect(driver, &background, &rects[index]);
+
+    _rtgui_topwin_compose_draw(&_rtgui_topwin_list, driver);
+
+#ifdef RTGUI_USING_MOUSE_CURSOR
+    rtgui_mouse_show_cursor();
+#endif
+    rtgui_screen_unlock();
+
+    rtgui_region_fini(&region);
+}
+#endif
+
 void rtgui_topwin_init(void)
 {
 }
@@ -132,6 +518,15 @@ rt_err_t rtgui_topwin_add(struct rtgui_event_win_create *event)
         topwin->flag |= WINTITLE_ONTOP;
     if (event->parent.user & RTGUI_WIN_STYLE_ONBTM)
         topwin->flag |= WINTITLE_ONBTM;
+#ifdef RTGUI_USING_BACKING_STORE
+    if (event->parent.user & RTGUI_WIN_STYLE_BACKING_STORE)
+        topwin->flag |= WINTITLE_BACKING;
+    topwin->backing = RT_NULL;
+    rtgui_region_init(&topwin->backing_valid);
+#endif
+#ifdef RTGUI_USING_COMPOSITOR
+    rtgui_region_init(&topwin->compose);
+#endif
 
     topwin->title = RT_NULL;
 
@@ -248,6 +643,14 @@ static struct rt_list_node *_rtgui_topwin_free_tree(struct rtgui_topwin *topwin)
         rtgui_free(monitor);
     }
 
+#ifdef RTGUI_USING_BACKING_STORE
+    _rtgui_topwin_backing_free(topwin);
+    rtgui_region_fini(&topwin->backing_valid);
+#endif
+#ifdef RTGUI_USING_COMPOSITOR
+    _rtgui_topwin_surface_free(topwin);
+    rtgui_region_fini(&topwin->compose);
+#endif
     rtgui_free(topwin);
     return next_node;
 }
@@ -447,7 +850,39 @@ rt_err_t rtgui_topwin_activate(struct rtgui_event_win_activate *event)
     return rtgui_topwin_activate_topwin(topwin);
 }
 
-static void _rtgui_topwin_draw_tree(struct rtgui_topwin *topwin, struct rtgui_event_paint *epaint)
+/* send the paint or clip event of size bytes to the window. It goes by pointer
+ * from the event pool, or by value when no block is left. */
+static void _rtgui_topwin_send_win_event(struct rtgui_topwin *topwin,
+                                         enum _rtgui_event_type type, rt_size_t size)
+{
+    struct rtgui_event_win *event;
+    union rtgui_event_generic generic;
+
+    RT_ASSERT(size <= sizeof(generic));
+
+#ifdef RTGUI_USING_EVENT_POOL
+    event = (struct rtgui_event_win *)rtgui_event_alloc(size);
+    if (event != RT_NULL)
+    {
+        rt_memset(event, 0, size);
+        RTGUI_EVENT_INIT(&(event->parent), type);
+        event->wid = topwin->wid;
+        rtgui_send_pooled(topwin->app, &(event->parent));
+        return;
+    }
+#endif
+
+    event = (struct rtgui_event_win *)&generic;
+    rt_memset(event, 0, size);
+    RTGUI_EVENT_INIT(&(event->parent), type);
+    event->wid = topwin->wid;
+    rtgui_send(topwin->app, &(event->parent), size);
+}
+
+#define _rtgui_topwin_send_paint(topwin) \
+    _rtgui_topwin_send_win_event((topwin), RTGUI_EVENT_PAINT, sizeof(struct rtgui_event_paint))
+
+static void _rtgui_topwin_draw_tree(struct rtgui_topwin *topwin)
 {
     struct rt_list_node *node;
 
@@ -455,23 +890,23 @@ static void _rtgui_topwin_draw_tree(struct rtgui_topwin *topwin, struct rtgui_ev
     {
         if (!(get_topwin_from_list(node)->flag & WINTITLE_SHOWN))
             break;
-        _rtgui_topwin_draw_tree(get_topwin_from_list(node), epaint);
+        _rtgui_topwin_draw_tree(get_topwin_from_list(node));
     }
 
-    epaint->wid = topwin->wid;
-    rtgui_send(topwin->app, &(epaint->parent), sizeof(*epaint));
+#ifdef RTGUI_USING_COMPOSITOR
+    /* show the surface in new order before the window paints */
+    rtgui_server_damage(&(topwin->extent));
+#endif
+    _rtgui_topwin_send_paint(topwin);
 }
 
 rt_err_t rtgui_topwin_activate_topwin(struct rtgui_topwin *topwin)
 {
     int tpmoved;
     struct rtgui_topwin *old_focus_topwin;
-    struct rtgui_event_paint epaint;
 
     RT_ASSERT(topwin != RT_NULL);
 
-    RTGUI_EVENT_PAINT_INIT(&epaint);
-
     if (!(topwin->flag & WINTITLE_SHOWN))
         return -RT_ERROR;
 
@@ -484,10 +919,9 @@ rt_err_t rtgui_topwin_activate_topwin(struct rtgui_topwin *topwin)
         tpmoved = _rtgui_topwin_raise_tree_from_root(topwin);
         rtgui_topwin_update_clip();
         if (tpmoved)
-            _rtgui_topwin_draw_tree(_rtgui_topwin_get_root_win(topwin),
-                                    &epaint);
+            _rtgui_topwin_draw_tree(_rtgui_topwin_get_root_win(topwin));
         else
-            _rtgui_topwin_draw_tree(topwin, &epaint);
+            _rtgui_topwin_draw_tree(topwin);
 
         return RT_EOK;
     }
@@ -514,10 +948,9 @@ rt_err_t rtgui_topwin_activate_topwin(struct rtgui_topwin *topwin)
     _rtgui_topwin_only_activate(topwin);
 
     if (tpmoved)
-        _rtgui_topwin_draw_tree(_rtgui_topwin_get_root_win(topwin),
-                                &epaint);
+        _rtgui_topwin_draw_tree(_rtgui_topwin_get_root_win(topwin));
     else
-        _rtgui_topwin_draw_tree(topwin, &epaint);
+        _rtgui_topwin_draw_tree(topwin);
 
     return RT_EOK;
 }
@@ -544,6 +977,10 @@ rt_inline void _rtgui_topwin_mark_hidden(struct rtgui_topwin *topwin)
 {
     topwin->flag &= ~WINTITLE_SHOWN;
     RTGUI_WIDGET_HIDE(topwin->wid);
+#ifdef RTGUI_USING_BACKING_STORE
+    /* the window does not draw while it's hidden */
+    rtgui_region_empty(&topwin->backing_valid);
+#endif
 }
 
 rt_inline void _rtgui_topwin_mark_shown(struct rtgui_topwin *topwin)
@@ -552,6 +989,11 @@ rt_inline void _rtgui_topwin_mark_shown(struct rtgui_topwin *topwin)
         return;
 
     topwin->flag |= WINTITLE_SHOWN;
+    /* the widgets may be changed while the window is hidden */
+    topwin->flag &= ~WINTITLE_CLIP_SYNCED;
+#ifdef RTGUI_USING_COMPOSITOR
+    _rtgui_topwin_surface_update(topwin);
+#endif
 
     if (RTGUI_WIDGET_IS_HIDE(topwin->wid))
     {
@@ -603,6 +1045,7 @@ static void _rtgui_topwin_clear_modal_tree(struct rtgui_topwin *topwin)
 _out:
     /* clear the modal flag of the root window */
     topwin->flag &= ~WINTITLE_MODALED;
+    _rtgui_topwin_grid_invalidate();
 }
 
 /* hide a window */
@@ -685,6 +1128,12 @@ rt_err_t rtgui_topwin_move(struct rtgui_event_win_move *event)
     old_rect = topwin->extent;
     /* move window rect */
     rtgui_rect_moveto(&(topwin->extent), dx, dy);
+    /* the widgets are moved, even the clip of window is the same */
+    topwin->flag &= ~WINTITLE_CLIP_SYNCED;
+#ifdef RTGUI_USING_COMPOSITOR
+    /* the pixels move with the surface */
+    _rtgui_topwin_surface_update(topwin);
+#endif
 
     /* move the monitor rect list */
     rtgui_list_foreach(node, &(topwin->monitor_list))
@@ -701,17 +1150,23 @@ rt_err_t rtgui_topwin_move(struct rtgui_event_win_move *event)
     /* update old window coverage area */
     rtgui_topwin_redraw(&old_rect);
 
+#ifdef RTGUI_USING_COMPOSITOR
+    /* compose the window in the new place, no paint is needed */
+    rtgui_topwin_redraw(&(topwin->extent));
+#else
     if (rtgui_rect_is_intersect(&old_rect, &(topwin->extent)) != RT_EOK)
     {
         /*
          * the old rect is not intersect with moved rect,
          * re-paint window
          */
-        struct rtgui_event_paint epaint;
-        RTGUI_EVENT_PAINT_INIT(&epaint);
-        epaint.wid = topwin->wid;
-        rtgui_send(topwin->app, &(epaint.parent), sizeof(epaint));
+#ifdef RTGUI_USING_BACKING_STORE
+        if (_rtgui_topwin_backing_restore(topwin, &(topwin->extent)) == RT_TRUE)
+            return RT_EOK;
+#endif
+        _rtgui_topwin_send_paint(topwin);
     }
+#endif
 
     return RT_EOK;
 }
@@ -737,6 +1192,13 @@ void rtgui_topwin_resize(struct rtgui_win *wid, rtgui_rect_t *rect)
     rtgui_region_union_rect(&region, &region, rect);
 
     topwin->extent = *rect;
+    topwin->flag &= ~WINTITLE_CLIP_SYNCED;
+#ifdef RTGUI_USING_BACKING_STORE
+    _rtgui_topwin_backing_free(topwin);
+#endif
+#ifdef RTGUI_USING_COMPOSITOR
+    _rtgui_topwin_surface_update(topwin);
+#endif
 
     /* update windows clip info */
     rtgui_topwin_update_clip();
@@ -744,6 +1206,11 @@ void rtgui_topwin_resize(struct rtgui_win *wid, rtgui_rect_t *rect)
     /* update old window coverage area */
     rtgui_topwin_redraw(rtgui_region_extents(&region));
 
+#ifdef RTGUI_USING_COMPOSITOR
+    /* the window paints on the new surface */
+    _rtgui_topwin_send_paint(topwin);
+#endif
+
     rtgui_region_fini(&region);
 }
 
@@ -804,6 +1271,197 @@ static struct rtgui_topwin *_rtgui_topwin_get_wnd_from_tree(struct rt_list_node
     return RT_NULL;
 }
 
+#ifdef RTGUI_USING_TOPWIN_GRID
+/*
+ * The hit grid keeps the shown windows in the order the tree is walked by
+ * _rtgui_topwin_get_wnd_from_tree, up to 32 of them. Each cell of screen has
+ * a bit for each window over it, and another bit for each window with a
+ * monitor rect over it. The lower bit is the higher window, so a lookup
+ * checks the windows of the cell from the lowest bit set.
+ */
+#define HIT_GRID_WINS   32
+
+struct rtgui_topwin_hit
+{
+    struct rtgui_topwin *topwin;
+    /* reached by the walk excluding modaled windows */
+    rt_bool_t reachable;
+};
+
+static struct rtgui_topwin_hit _hit_wins[HIT_GRID_WINS];
+static rt_uint32_t _hit_cells[RTGUI_TOPWIN_GRID][RTGUI_TOPWIN_GRID];
+static rt_uint32_t _hit_monitor_cells[RTGUI_TOPWIN_GRID][RTGUI_TOPWIN_GRID];
+static int _hit_count;
+/* too many windows for the grid */
+static rt_bool_t _hit_overflow;
+static int _hit_width, _hit_height;
+static int _hit_cell_width, _hit_cell_height;
+
+static void _rtgui_topwin_grid_mark(rt_uint32_t cells[RTGUI_TOPWIN_GRID][RTGUI_TOPWIN_GRID],
+                                    struct rtgui_rect *rect, rt_uint32_t bit)
+{
+    int cx, cy, cx1, cy1, cx2, cy2;
+
+    cx1 = _UI_MAX(rect->x1, 0);
+    cy1 = _UI_MAX(rect->y1, 0);
+    cx2 = _UI_MIN(rect->x2, _hit_width);
+    cy2 = _UI_MIN(rect->y2, _hit_height);
+    if (cx1 >= cx2 || cy1 >= cy2)
+        return;
+
+    cx1 = cx1 / _hit_cell_width;
+    cy1 = cy1 / _hit_cell_height;
+    cx2 = (cx2 - 1) / _hit_cell_width;
+    cy2 = (cy2 - 1) / _hit_cell_height;
+    for (cy = cy1; cy <= cy2; cy ++)
+    {
+        for (cx = cx1; cx <= cx2; cx ++)
+            cells[cy][cx] |= bit;
+    }
+}
+
+static void _rtgui_topwin_grid_add(struct rtgui_topwin *topwin, rt_bool_t reachable)
+{
+    rt_uint32_t bit;
+    struct rtgui_list_node *node;
+
+    if (_hit_count == HIT_GRID_WINS)
+    {
+        _hit_overflow = RT_TRUE;
+        return;
+    }
+
+    bit = 1UL << _hit_count;
+    _hit_wins[_hit_count].topwin = topwin;
+    _hit_wins[_hit_count].reachable = reachable;
+    _hit_count ++;
+
+    _rtgui_topwin_grid_mark(_hit_cells, &topwin->extent, bit);
+    rtgui_list_foreach(node, &(topwin->monitor_list))
+    {
+        struct rtgui_mouse_monitor *monitor = rtgui_list_entry(node,
+                                              struct rtgui_mouse_monitor, list);
+
+        _rtgui_topwin_grid_mark(_hit_monitor_cells, &monitor->rect, bit);
+    }
+}
+
+/* the same order as _rtgui_topwin_get_wnd_from_tree */
+static void _rtgui_topwin_grid_add_tree(struct rt_list_node *list, rt_bool_t cut)
+{
+    struct rt_list_node *node;
+    struct rtgui_topwin *topwin;
+
+    rt_list_foreach(node, list, next)
+    {
+        topwin = get_topwin_from_list(node);
+        if (!(topwin->flag & WINTITLE_SHOWN))
+            break;
+
+        _rtgui_topwin_grid_add_tree(&topwin->child_list, cut);
+
+        /* the walk excluding modaled windows stops here in this list */
+        if (topwin->flag & WINTITLE_MODALED)
+            cut = RT_TRUE;
+        _rtgui_topwin_grid_add(topwin, !cut);
+    }
+}
+
+static void _rtgui_topwin_grid_build(void)
+{
+    struct rtgui_graphic_driver *driver;
+
+    driver = rtgui_graphic_driver_get_default();
+    _hit_width  = driver->width;
+    _hit_height = driver->height;
+    _hit_cell_width  = (_hit_width + RTGUI_TOPWIN_GRID - 1) / RTGUI_TOPWIN_GRID;
+    _hit_cell_height = (_hit_height + RTGUI_TOPWIN_GRID - 1) / RTGUI_TOPWIN_GRID;
+    if (_hit_cell_width == 0)
+        _hit_cell_width = 1;
+    if (_hit_cell_height == 0)
+        _hit_cell_height = 1;
+
+    rt_memset(_hit_cells, 0, sizeof(_hit_cells));
+    rt_memset(_hit_monitor_cells, 0, sizeof(_hit_monitor_cells));
+    _hit_count = 0;
+    _hit_overflow = RT_FALSE;
+
+    _rtgui_topwin_grid_add_tree(&_rtgui_topwin_list, RT_FALSE);
+    _hit_grid_valid = RT_TRUE;
+}
+
+/* the bits of windows over the cell of (x, y). RT_FALSE if the grid can't
+ * tell, for too many windows or a point out of screen */
+static rt_bool_t _rtgui_topwin_grid_cell(rt_uint32_t cells[RTGUI_TOPWIN_GRID][RTGUI_TOPWIN_GRID],
+                                         int x, int y, rt_uint32_t *bits)
+{
+    if (!_hit_grid_valid)
+        _rtgui_topwin_grid_build();
+    if (_hit_overflow)
+        return RT_FALSE;
+    if (x < 0 || y < 0 || x >= _hit_width || y >= _hit_height)
+        return RT_FALSE;
+
+    *bits = cells[y / _hit_cell_height][x / _hit_cell_width];
+
+    return RT_TRUE;
+}
+
+static struct rtgui_topwin *_rtgui_topwin_get_wnd_from_grid(int x, int y,
+                                                            rt_bool_t exclude_modaled)
+{
+    int index;
+    rt_uint32_t bits;
+
+    if (_rtgui_topwin_grid_cell(_hit_cells, x, y, &bits) == RT_FALSE)
+        return _rtgui_topwin_get_wnd_from_tree(&_rtgui_topwin_list, x, y, exclude_modaled);
+
+    for (index = 0; bits != 0; index ++, bits >>= 1)
+    {
+        if (!(bits & 0x01))
+            continue;
+        if (exclude_modaled && !_hit_wins[index].reachable)
+            continue;
+
+        if (rtgui_rect_contains_point(&(_hit_wins[index].topwin->extent), x, y) == RT_EOK)
+            return _hit_wins[index].topwin;
+    }
+
+    return RT_NULL;
+}
+
+struct rtgui_topwin *rtgui_topwin_get_wnd(int x, int y)
+{
+    return _rtgui_topwin_get_wnd_from_grid(x, y, RT_FALSE);
+}
+
+struct rtgui_topwin *rtgui_topwin_get_wnd_no_modaled(int x, int y)
+{
+    return _rtgui_topwin_get_wnd_from_grid(x, y, RT_TRUE);
+}
+
+rt_bool_t rtgui_topwin_monitor_contains_point(struct rtgui_topwin *topwin, int x, int y)
+{
+    int index;
+    rt_uint32_t bits;
+
+    RT_ASSERT(topwin != RT_NULL);
+
+    if (_rtgui_topwin_grid_cell(_hit_monitor_cells, x, y, &bits) == RT_TRUE)
+    {
+        /* no monitor rect of the window is over the cell */
+        for (index = 0; index < _hit_count; index ++)
+        {
+            if (_hit_wins[index].topwin == topwin)
+                break;
+        }
+        if (index < _hit_count && !(bits & (1UL << index)))
+            return RT_FALSE;
+    }
+
+    return rtgui_mouse_monitor_contains_point(&(topwin->monitor_list), x, y);
+}
+#else
 struct rtgui_topwin *rtgui_topwin_get_wnd(int x, int y)
 {
     return _rtgui_topwin_get_wnd_from_tree(&_rtgui_topwin_list, x, y, RT_FALSE);
@@ -814,32 +1472,71 @@ struct rtgui_topwin *rtgui_topwin_get_wnd_no_modaled(int x, int y)
     return _rtgui_topwin_get_wnd_from_tree(&_rtgui_topwin_list, x, y, RT_TRUE);
 }
 
+rt_bool_t rtgui_topwin_monitor_contains_point(struct rtgui_topwin *topwin, int x, int y)
+{
+    RT_ASSERT(topwin != RT_NULL);
+
+    return rtgui_mouse_monitor_contains_point(&(topwin->monitor_list), x, y);
+}
+#endif
+
 /* clip region from topwin, and the windows beneath it. */
-rt_inline void _rtgui_topwin_clip_to_region(struct rtgui_topwin *topwin,
-                                            struct rtgui_region *region)
+/* clip the topwin to region, return RT_TRUE if the clip is changed or the
+ * window has not got its clip yet */
+rt_inline rt_bool_t _rtgui_topwin_clip_to_region(struct rtgui_topwin *topwin,
+                                                 struct rtgui_region *region)
 {
+    rt_bool_t changed;
+    struct rtgui_region clip;
+
     RT_ASSERT(region != RT_NULL);
     RT_ASSERT(topwin != RT_NULL);
 
-    rtgui_region_reset(&topwin->wid->outer_clip, &topwin->wid->outer_extent);
-    rtgui_region_intersect(&topwin->wid->outer_clip, &topwin->wid->outer_clip, region);
+    /* in compositor, the window draws all of its surface */
+    rtgui_region_init_with_extents(&clip, &topwin->wid->outer_extent);
+#ifndef RTGUI_USING_COMPOSITOR
+    rtgui_region_intersect(&clip, &clip, region);
+#endif
+
+    changed = !(topwin->flag & WINTITLE_CLIP_SYNCED) ||
+              rtgui_region_is_equal(&clip, &topwin->wid->outer_clip) != RT_EOK;
+    if (changed)
+    {
+        rtgui_region_copy(&topwin->wid->outer_clip, &clip);
+        topwin->flag |= WINTITLE_CLIP_SYNCED;
+    }
+    rtgui_region_fini(&clip);
+
+    return changed;
 }
 
+void rtgui_topwin_get_clip_stat(struct rtgui_topwin_clip_stat *stat)
+{
+    RT_ASSERT(stat != RT_NULL);
+
+    *stat = _clip_stat;
+}
+RTM_EXPORT(rtgui_topwin_get_clip_stat);
+
+/* The outer clip of every shown window is still computed from the screen on
+ * each change, only the notification is incremental: the windows with the
+ * changed clip get the clip event, so a window popped on top does not make
+ * all the windows update their widget clips. */
 static void rtgui_topwin_update_clip(void)
 {
     struct rtgui_topwin *top;
-    struct rtgui_event_clip_info eclip;
     /* Note that the region is a "female die", that means it's the region you
      * can paint to, not the region covered by others.
      */
     struct rtgui_region region_available;
 
+    /* the windows are shown, hidden, moved or raised */
+    _rtgui_topwin_grid_invalidate();
+
     if (rt_list_isempty(&_rtgui_topwin_list) ||
         !(get_topwin_from_list(_rtgui_topwin_list.next)->flag & WINTITLE_SHOWN))
         return;
 
-    RTGUI_EVENT_CLIP_INFO_INIT(&eclip);
-
     rtgui_region_init_rect(&region_available, 0, 0,
                            rtgui_graphic_driver_get_default()->width,
                            rtgui_graphic_driver_get_default()->height);
@@ -855,15 +1552,21 @@ static void rtgui_topwin_update_clip(void)
     while (top != RT_NULL)
     {
         /* clip the topwin */
-        _rtgui_topwin_clip_to_region(top, &region_available);
+        if (_rtgui_topwin_clip_to_region(top, &region_available) == RT_TRUE)
+        {
+            /* send clip event to destination window */
+            _rtgui_topwin_send_win_event(top, RTGUI_EVENT_CLIP_INFO,
+                                         sizeof(struct rtgui_event_clip_info));
+            _clip_stat.sent ++;
+        }
+        else
+        {
+            _clip_stat.skipped ++;
+        }
 
         /* update available region */
         rtgui_region_subtract_rect(&region_available, &region_available, &top->extent);
 
-        /* send clip event to destination window */
-        eclip.wid = top->wid;
-        rtgui_send(top->app, &(eclip.parent), sizeof(struct rtgui_event_clip_info));
-
         /* move to next sibling tree */
         if (top->parent == RT_NULL)
         {
@@ -889,15 +1592,14 @@ static void rtgui_topwin_update_clip(void)
     rtgui_region_fini(&region_available);
 }
 
+#ifndef RTGUI_USING_COMPOSITOR
 static void _rtgui_topwin_redraw_tree(struct rt_list_node *list,
-                                      struct rtgui_rect *rect,
-                                      struct rtgui_event_paint *epaint)
+                                      struct rtgui_rect *rect)
 {
     struct rt_list_node *node;
 
     RT_ASSERT(list != RT_NULL);
     RT_ASSERT(rect != RT_NULL);
-    RT_ASSERT(epaint != RT_NULL);
 
     /* skip the hidden windows */
     rt_list_foreach(node, list, prev)
@@ -915,21 +1617,27 @@ static void _rtgui_topwin_redraw_tree(struct rt_list_node *list,
         //FIXME: intersect with clip?
         if (rtgui_rect_is_intersect(rect, &(topwin->extent)) == RT_EOK)
         {
-            epaint->wid = topwin->wid;
-            rtgui_send(topwin->app, &(epaint->parent), sizeof(*epaint));
+#ifdef RTGUI_USING_BACKING_STORE
+            if (_rtgui_topwin_backing_restore(topwin, rect) == RT_FALSE)
+#endif
+            {
+                _rtgui_topwin_send_paint(topwin);
+            }
         }
 
-        _rtgui_topwin_redraw_tree(&topwin->child_list, rect, epaint);
+        _rtgui_topwin_redraw_tree(&topwin->child_list, rect);
     }
 }
+#endif
 
 static void rtgui_topwin_redraw(struct rtgui_rect *rect)
 {
-    struct rtgui_event_paint epaint;
-    RTGUI_EVENT_PAINT_INIT(&epaint);
-    epaint.wid = RT_NULL;
-
-    _rtgui_topwin_redraw_tree(&_rtgui_topwin_list, rect, &epaint);
+#ifdef RTGUI_USING_COMPOSITOR
+    /* the surfaces keep the pixels, compose them again */
+    rtgui_server_damage(rect);
+#else
+    _rtgui_topwin_redraw_tree(&_rtgui_topwin_list, rect);
+#endif
 }
 
 /* a window enter modal mode will modal all the sibling window and parent
@@ -963,6 +1671,7 @@ rt_err_t rtgui_topwin_modal_enter(struct rtgui_event_win_modal_enter *event)
 
     topwin->flag &= ~WINTITLE_MODALED;
     topwin->flag |= WINTITLE_MODALING;
+    _rtgui_topwin_grid_invalidate();
 
     return RT_EOK;
 }
@@ -981,6 +1690,7 @@ void rtgui_topwin_append_monitor_rect(struct rtgui_win *wid, rtgui_rect_t *rect)
 
     /* append rect to top window monitor rect list */
     rtgui_mouse_monitor_append(&(win->monitor_list), rect);
+    _rtgui_topwin_grid_invalidate();
 }
 
 void rtgui_topwin_remove_monitor_rect(struct rtgui_win *wid, rtgui_rect_t *rect)
@@ -998,6 +1708,7 @@ void rtgui_topwin_remove_monitor_rect(struct rtgui_win *wid, rtgui_rect_t *rect)
 
     /* remove rect from top window monitor rect list */
     rtgui_mouse_monitor_remove(&(win->monitor_list), rect);
+    _rtgui_topwin_grid_invalidate();
 }
 
 static struct rtgui_object* _get_obj_in_topwin(struct rtgui_topwin *topwin,
@@ -1040,6 +1751,13 @@ struct rtgui_object* rtgui_get_object(struct rtgui_app *app, rt_uint32_t id)
     if (object->id == id)
         return object;
 
+#ifdef RTGUI_USING_ID_HASH
+    object = rtgui_app_id_find(app, id);
+    if (object)
+        return object;
+#endif
+
+    /* the objects still have the address as ID */
     rt_list_foreach(node, &_rtgui_topwin_list, next)
     {
         struct rtgui_topwin *topwin;
@@ -1103,4 +1821,10 @@ void dump_tree()
     rtgui_topwin_dump_tree();
 }
 FINSH_FUNCTION_EXPORT(dump_tree, dump rtgui topwin tree)
+
+void list_clip(void)
+{
+    rt_kprintf("clip events: %d sent, %d skipped\n", _clip_stat.sent, _clip_stat.skipped);
+}
+FINSH_FUNCTION_EXPORT(list_clip, display window clip update statistics);
 #endif
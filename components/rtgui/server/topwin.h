@@ -40,6 +40,8 @@ rt_err_t rtgui_topwin_modal_enter(struct rtgui_event_win_modal_enter *event);
 /* get window at (x, y) */
 struct rtgui_topwin *rtgui_topwin_get_wnd(int x, int y);
 struct rtgui_topwin *rtgui_topwin_get_wnd_no_modaled(int x, int y);
+/* whether (x, y) is in a monitor rect of window */
+rt_bool_t rtgui_topwin_monitor_contains_point(struct rtgui_topwin *topwin, int x, int y);
 
 //void rtgui_topwin_deactivate_win(struct rtgui_topwin* win);
 
@@ -51,6 +53,16 @@ void rtgui_topwin_title_onmouse(struct rtgui_topwin *win, struct rtgui_event_mou
 void rtgui_topwin_append_monitor_rect(struct rtgui_win *wid, rtgui_rect_t *rect);
 void rtgui_topwin_remove_monitor_rect(struct rtgui_win *wid, rtgui_rect_t *rect);
 
+#ifdef RTGUI_USING_BACKING_STORE
+/* copy the drawing of window in rect to its backing store */
+void rtgui_topwin_backing_save(struct rtgui_win *wid, rtgui_rect_t *rect);
+#endif
+
+#ifdef RTGUI_USING_COMPOSITOR
+/* compose the damage of screen from the surface of windows */
+void rtgui_topwin_compose(rtgui_region_t *damage);
+#endif
+
 /* get the topwin that is currently focused */
 struct rtgui_topwin *rtgui_topwin_get_focus(void);
 #endif
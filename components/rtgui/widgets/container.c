@@ -239,6 +239,11 @@ void rtgui_container_remove_child(rtgui_container_t *container, rtgui_widget_t *
 
     rtgui_widget_unfocus(child);
 
+#ifdef RTGUI_USING_DEFERRED_PAINT
+    /* the window can not paint the child and its children any more */
+    rtgui_widget_forget_dirty(child);
+#endif
+
     /* remove widget from parent's children list */
     rtgui_list_remove(&(container->children), &(child->sibling));
 
@@ -327,6 +332,22 @@ struct rtgui_object* rtgui_container_get_object(struct rtgui_container *containe
                                                 rt_uint32_t id)
 {
     struct rtgui_list_node *node;
+#ifdef RTGUI_USING_ID_HASH
+    struct rtgui_object *found;
+
+    /* take the object in table if it's inside the container */
+    found = rtgui_app_id_find(rtgui_app_self(), id);
+    if (found != RT_NULL && RTGUI_IS_WIDGET(found))
+    {
+        struct rtgui_widget *parent;
+
+        for (parent = RTGUI_WIDGET(found)->parent; parent != RT_NULL; parent = parent->parent)
+        {
+            if (parent == RTGUI_WIDGET(container))
+                return found;
+        }
+    }
+#endif
 
     rtgui_list_foreach(node, &(container->children))
     {
@@ -796,6 +796,9 @@ static void rtgui_edit_onmouse(struct rtgui_edit *edit, struct rtgui_event_mouse
     RT_ASSERT(emouse);
 
     rtgui_widget_get_rect(RTGUI_WIDGET(edit), &rect);
+#ifdef RTGUI_USING_LAZY_CLIP
+    rtgui_widget_validate_clip(RTGUI_WIDGET(edit));
+#endif
     if ((rtgui_region_contains_point(&(RTGUI_WIDGET(edit)->clip), emouse->x, emouse->y, &rect) == RT_EOK))
     {
         rt_uint16_t x, y;
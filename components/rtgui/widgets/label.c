@@ -12,6 +12,7 @@
  * 2009-10-16     Bernard      first version
  */
 #include <rtgui/dc.h>
+#include <rtgui/dc_record.h>
 #include <rtgui/widgets/label.h>
 #include <rtgui/rtgui_system.h>
 #include <rtgui/rtgui_theme.h>
@@ -24,6 +25,9 @@ static void _rtgui_label_constructor(rtgui_label_t *label)
 
     /* set field */
     label->text = RT_NULL;
+#ifdef RTGUI_USING_DC_RECORD
+    label->record = RT_NULL;
+#endif
 }
 
 static void _rtgui_label_destructor(rtgui_label_t *label)
@@ -32,6 +36,12 @@ static void _rtgui_label_destructor(rtgui_label_t *label)
     if (label->text)
         rt_free(label->text);
     label->text = RT_NULL;
+
+#ifdef RTGUI_USING_DC_RECORD
+    if (label->record != RT_NULL)
+        rtgui_dc_destory(label->record);
+    label->record = RT_NULL;
+#endif
 }
 
 DEFINE_CLASS_TYPE(label, "label",
@@ -115,8 +125,14 @@ void rtgui_label_set_text(rtgui_label_t *label, const char *text)
     else
         label->text = RT_NULL;
 
-    /* update widget */
-    rtgui_widget_update(RTGUI_WIDGET(label));
+#ifdef RTGUI_USING_DC_RECORD
+    /* drop the drawing of old text */
+    if (label->record != RT_NULL)
+        rtgui_dc_record_reset(label->record);
+#endif
+
+    /* paint the new text later */
+    rtgui_widget_invalidate(RTGUI_WIDGET(label), RT_NULL);
 }
 RTM_EXPORT(rtgui_label_set_text);
 
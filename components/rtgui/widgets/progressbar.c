@@ -79,7 +79,7 @@ void rtgui_progressbar_set_value(struct rtgui_progressbar *bar, int value)
 
     bar->position = value;
 
-    rtgui_theme_draw_progressbar(bar);
+    rtgui_widget_invalidate(RTGUI_WIDGET(bar), RT_NULL);
     return;
 }
 RTM_EXPORT(rtgui_progressbar_set_value);
@@ -98,7 +98,7 @@ void rtgui_progressbar_set_range(struct rtgui_progressbar *bar, int range)
 
     bar->range = range;
 
-    rtgui_theme_draw_progressbar(bar);
+    rtgui_widget_invalidate(RTGUI_WIDGET(bar), RT_NULL);
     return;
 }
 RTM_EXPORT(rtgui_progressbar_set_range);
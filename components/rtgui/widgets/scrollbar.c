@@ -739,7 +739,7 @@ void rtgui_scrollbar_set_value(rtgui_scrollbar_t* bar, rt_int16_t value)
 
 	if(bar->value < 0) bar->value = 0;
 
-	rtgui_widget_update(RTGUI_WIDGET(bar));
+	rtgui_widget_invalidate(RTGUI_WIDGET(bar), RT_NULL);
 }
 
 void rtgui_scrollbar_set_onscroll(rtgui_scrollbar_t* bar, rtgui_event_handler_ptr handler)
@@ -224,7 +224,7 @@ void rtgui_slider_set_value(struct rtgui_slider *slider, rt_size_t value)
         if (slider->value != value)
         {
             slider->value = value;
-            rtgui_theme_draw_slider(slider);
+            rtgui_widget_invalidate(RTGUI_WIDGET(slider), RT_NULL);
         }
     }
 }
@@ -76,16 +76,29 @@ static void _rtgui_widget_constructor(rtgui_widget_t *widget)
 
     /* init clip information */
     rtgui_region_init(&(widget->clip));
+#ifdef RTGUI_USING_LAZY_CLIP
+    widget->clip_gen = 0;
+    widget->flag |= RTGUI_WIDGET_FLAG_CLIP_DIRTY;
+#endif
 
     /* init hardware dc */
     rtgui_dc_client_init(widget);
 }
 
 /* Destroys the widget */
+#ifdef RTGUI_USING_DEFERRED_PAINT
+static void _rtgui_widget_forget_dirty(rtgui_widget_t *widget);
+#endif
+
 static void _rtgui_widget_destructor(rtgui_widget_t *widget)
 {
     if (widget == RT_NULL) return;
 
+#ifdef RTGUI_USING_DEFERRED_PAINT
+    if (widget->flag & RTGUI_WIDGET_FLAG_PAINT_DIRTY)
+        _rtgui_widget_forget_dirty(widget);
+#endif
+
     if (widget->parent != RT_NULL && RTGUI_IS_CONTAINER(widget->parent))
     {
         /* remove widget from parent's children list */
@@ -482,6 +495,13 @@ rt_bool_t rtgui_widget_onupdate_toplvl(struct rtgui_object *object, struct rtgui
     widget = RTGUI_WIDGET(object);
     eup = (struct rtgui_event_update_toplvl *)event;
 
+#ifdef RTGUI_USING_DEFERRED_PAINT
+    /* the old window can not paint it any more */
+    if ((widget->flag & RTGUI_WIDGET_FLAG_PAINT_DIRTY) &&
+        widget->toplevel != eup->toplvl)
+        _rtgui_widget_forget_dirty(widget);
+#endif
+
     widget->toplevel = eup->toplvl;
 
     return RT_FALSE;
@@ -527,6 +547,133 @@ RTM_EXPORT(rtgui_widget_event_handler);
 /*
  * This function updates the clip info of widget
  */
+#ifdef RTGUI_USING_LAZY_CLIP
+/*
+ * The clip of widget is the window clip in the extents of widget and all of
+ * its parents, subtracted the extents of the shown non-transparent children
+ * (and the children of transparent children). The clips are not computed when
+ * they change, but marked out of date in two ways:
+ *
+ *  - the window clip changes: the clip generation of window changes, all the
+ *    widget clips in window are out of date.
+ *  - the layout in window changes: the widget and its children are marked
+ *    dirty, and the parents up to the first non-transparent one, which lose
+ *    or get the area of widget. The other subtrees are not touched.
+ *
+ * The clip is computed when the widget begins drawing.
+ */
+static void _rtgui_widget_clip_invalidate_tree(rtgui_widget_t *widget)
+{
+    struct rtgui_list_node *node;
+
+    widget->flag |= RTGUI_WIDGET_FLAG_CLIP_DIRTY;
+
+    if (RTGUI_IS_CONTAINER(widget))
+    {
+        rtgui_list_foreach(node, &(RTGUI_CONTAINER(widget)->children))
+        {
+            _rtgui_widget_clip_invalidate_tree(rtgui_list_entry(node, rtgui_widget_t, sibling));
+        }
+    }
+    else if (RTGUI_IS_NOTEBOOK(widget))
+    {
+        widget = rtgui_notebook_get_current(RTGUI_NOTEBOOK(widget));
+        if (widget != RT_NULL)
+            _rtgui_widget_clip_invalidate_tree(widget);
+    }
+}
+
+static void _rtgui_widget_clip_invalidate_parents(rtgui_widget_t *widget)
+{
+    for (widget = widget->parent; widget != RT_NULL; widget = widget->parent)
+    {
+        widget->flag |= RTGUI_WIDGET_FLAG_CLIP_DIRTY;
+        if (!(widget->flag & RTGUI_WIDGET_FLAG_TRANSPARENT))
+            break;
+    }
+}
+
+/* subtract the shown non-transparent children of node from the widget clip */
+static void _rtgui_widget_clip_subtract_children(rtgui_widget_t *widget, rtgui_widget_t *node)
+{
+    struct rtgui_list_node *list_node;
+    rtgui_widget_t *child;
+
+    if (RTGUI_IS_CONTAINER(node))
+    {
+        rtgui_list_foreach(list_node, &(RTGUI_CONTAINER(node)->children))
+        {
+            child = rtgui_list_entry(list_node, rtgui_widget_t, sibling);
+            if (RTGUI_WIDGET_IS_HIDE(child))
+                continue;
+
+            if (child->flag & RTGUI_WIDGET_FLAG_TRANSPARENT)
+                _rtgui_widget_clip_subtract_children(widget, child);
+            else
+                rtgui_region_subtract_rect(&(widget->clip), &(widget->clip), &(child->extent));
+        }
+    }
+    else if (RTGUI_IS_NOTEBOOK(node))
+    {
+        child = rtgui_notebook_get_current(RTGUI_NOTEBOOK(node));
+        if (child == RT_NULL || RTGUI_WIDGET_IS_HIDE(child))
+            return;
+
+        if (child->flag & RTGUI_WIDGET_FLAG_TRANSPARENT)
+            _rtgui_widget_clip_subtract_children(widget, child);
+        else
+            rtgui_region_subtract_rect(&(widget->clip), &(widget->clip), &(child->extent));
+    }
+}
+
+void rtgui_widget_validate_clip(rtgui_widget_t *widget)
+{
+    rtgui_rect_t rect;
+    rtgui_widget_t *parent;
+    struct rtgui_win *win;
+
+    RT_ASSERT(widget != RT_NULL);
+
+    win = widget->toplevel;
+    /* the title clip is computed with window clip */
+    if (win == RT_NULL || widget == RTGUI_WIDGET(win->_title_wgt))
+        return;
+
+    if (!(widget->flag & RTGUI_WIDGET_FLAG_CLIP_DIRTY) && widget->clip_gen == win->clip_gen)
+        return;
+
+    rect = widget->extent;
+    for (parent = widget->parent; parent != RT_NULL; parent = parent->parent)
+        rtgui_rect_intersect(&(parent->extent), &rect);
+
+    if (rect.x1 < rect.x2 && rect.y1 < rect.y2)
+        rtgui_region_intersect_rect(&(widget->clip), &(win->outer_clip), &rect);
+    else
+        rtgui_region_empty(&(widget->clip));
+
+    /* the children of a container cover it */
+    if (!(widget->flag & RTGUI_WIDGET_FLAG_TRANSPARENT) && RTGUI_IS_CONTAINER(widget))
+        _rtgui_widget_clip_subtract_children(widget, widget);
+
+    widget->flag &= ~RTGUI_WIDGET_FLAG_CLIP_DIRTY;
+    widget->clip_gen = win->clip_gen;
+}
+RTM_EXPORT(rtgui_widget_validate_clip);
+
+void rtgui_widget_update_clip(rtgui_widget_t *widget)
+{
+    /* no widget or widget is hide, no update clip */
+    if (widget == RT_NULL || RTGUI_WIDGET_IS_HIDE(widget))
+        return;
+
+    /* if there is no parent, there is no clip to update. */
+    if (widget->parent == RT_NULL) return;
+
+    _rtgui_widget_clip_invalidate_tree(widget);
+    _rtgui_widget_clip_invalidate_parents(widget);
+}
+RTM_EXPORT(rtgui_widget_update_clip);
+#else
 void rtgui_widget_update_clip(rtgui_widget_t *widget)
 {
     struct rtgui_list_node *node;
@@ -584,6 +731,7 @@ void rtgui_widget_update_clip(rtgui_widget_t *widget)
     }
 }
 RTM_EXPORT(rtgui_widget_update_clip);
+#endif
 
 void rtgui_widget_show(struct rtgui_widget *widget)
 {
@@ -611,6 +759,10 @@ rt_bool_t rtgui_widget_onshow(struct rtgui_object *object, struct rtgui_event *e
         return RT_FALSE;
 
     RTGUI_WIDGET_UNHIDE(widget);
+#ifdef RTGUI_USING_LAZY_CLIP
+    /* the parent loses the area of widget */
+    rtgui_widget_update_clip(widget);
+#endif
 
     return RT_FALSE;
 }
@@ -628,6 +780,10 @@ rt_bool_t rtgui_widget_onhide(struct rtgui_object *object, struct rtgui_event *e
 
     if (widget->parent != RT_NULL)
     {
+#ifdef RTGUI_USING_LAZY_CLIP
+        /* the parent gets the area of widget back */
+        _rtgui_widget_clip_invalidate_parents(widget);
+#else
         rtgui_widget_t *parent;
 
         parent = widget->parent;
@@ -639,6 +795,7 @@ rt_bool_t rtgui_widget_onhide(struct rtgui_object *object, struct rtgui_event *e
 
         /* give my clip back to parent */
         rtgui_region_union(&(parent->clip), &(parent->clip), &(widget->clip));
+#endif
     }
 
     return RT_FALSE;
@@ -714,6 +871,110 @@ void rtgui_widget_update(rtgui_widget_t *widget)
 }
 RTM_EXPORT(rtgui_widget_update);
 
+#ifdef RTGUI_USING_DEFERRED_PAINT
+static void _rtgui_widget_add_dirty(struct rtgui_win *win, rtgui_widget_t *widget)
+{
+    int index;
+
+    if (widget->flag & RTGUI_WIDGET_FLAG_PAINT_DIRTY)
+        return;
+
+    if (win->dirty_count == RTGUI_WIN_DIRTY_WIDGETS)
+    {
+        /* too many widgets, paint the whole window instead */
+        for (index = 0; index < win->dirty_count; index ++)
+            win->dirty_widgets[index]->flag &= ~RTGUI_WIDGET_FLAG_PAINT_DIRTY;
+        win->dirty_count = 0;
+        widget = RTGUI_WIDGET(win);
+    }
+
+    widget->flag |= RTGUI_WIDGET_FLAG_PAINT_DIRTY;
+    win->dirty_widgets[win->dirty_count ++] = widget;
+}
+
+void rtgui_widget_invalidate(rtgui_widget_t *widget, rtgui_rect_t *rect)
+{
+    rtgui_rect_t area;
+    struct rtgui_win *win;
+    struct rtgui_app *app;
+
+    RT_ASSERT(widget != RT_NULL);
+
+    win = widget->toplevel;
+    /* not in a window, nothing to paint on */
+    if (win == RT_NULL || RTGUI_WIDGET_IS_HIDE(widget))
+        return;
+
+    if (rect != RT_NULL)
+    {
+        area = *rect;
+        rtgui_widget_rect_to_device(widget, &area);
+        rtgui_rect_intersect(&(widget->extent), &area);
+    }
+    else
+    {
+        area = widget->extent;
+    }
+    if (area.x1 >= area.x2 || area.y1 >= area.y2)
+        return;
+
+    rtgui_region_union_rect(&(win->dirty), &(win->dirty), &area);
+
+    if (win->dirty_count == 0)
+    {
+        /* link the window to application */
+        app = win->app;
+        if (app->dirty_wins == RT_NULL)
+            app->dirty_tick = rt_tick_get();
+        win->dirty_next = app->dirty_wins;
+        app->dirty_wins = win;
+    }
+    _rtgui_widget_add_dirty(win, widget);
+}
+RTM_EXPORT(rtgui_widget_invalidate);
+
+static void _rtgui_widget_forget_dirty(rtgui_widget_t *widget)
+{
+    int index;
+    struct rtgui_win *win = widget->toplevel;
+
+    widget->flag &= ~RTGUI_WIDGET_FLAG_PAINT_DIRTY;
+    if (win == RT_NULL || widget == RTGUI_WIDGET(win))
+        return;
+
+    for (index = 0; index < win->dirty_count; index ++)
+    {
+        if (win->dirty_widgets[index] == widget)
+            break;
+    }
+    if (index == win->dirty_count)
+        return;
+
+    /* the window paints the dirty region instead */
+    win->dirty_widgets[index] = win->dirty_widgets[-- win->dirty_count];
+    _rtgui_widget_add_dirty(win, RTGUI_WIDGET(win));
+}
+
+void rtgui_widget_forget_dirty(rtgui_widget_t *widget)
+{
+    struct rtgui_list_node *node;
+
+    RT_ASSERT(widget != RT_NULL);
+
+    if (widget->flag & RTGUI_WIDGET_FLAG_PAINT_DIRTY)
+        _rtgui_widget_forget_dirty(widget);
+
+    if (RTGUI_IS_CONTAINER(widget))
+    {
+        rtgui_list_foreach(node, &(RTGUI_CONTAINER(widget)->children))
+        {
+            rtgui_widget_forget_dirty(rtgui_list_entry(node, rtgui_widget_t, sibling));
+        }
+    }
+}
+RTM_EXPORT(rtgui_widget_forget_dirty);
+#endif
+
 rtgui_widget_t *rtgui_widget_get_next_sibling(rtgui_widget_t *widget)
 {
     rtgui_widget_t *sibling = RT_NULL;
@@ -44,6 +44,22 @@ static void _rtgui_win_constructor(rtgui_win_t *win)
     win->title         = RT_NULL;
     win->_title_wgt    = RT_NULL;
     win->modal_code    = RTGUI_MODAL_OK;
+#ifdef RTGUI_USING_COMPOSITOR
+    win->surface       = RT_NULL;
+    win->alpha         = 255;
+#endif
+#ifdef RTGUI_USING_LAZY_CLIP
+    win->clip_gen      = 0;
+#endif
+#ifdef RTGUI_USING_DEFERRED_PAINT
+    rtgui_region_init(&win->dirty);
+    win->dirty_count   = 0;
+    win->dirty_next    = RT_NULL;
+#endif
+#ifdef RTGUI_USING_ASYNC_ACK
+    win->create_ack    = RT_NULL;
+    win->show_ack      = RT_NULL;
+#endif
 
     /* initialize last mouse event handled widget */
     win->last_mevent_widget = RT_NULL;
@@ -67,6 +83,21 @@ static void _rtgui_win_destructor(rtgui_win_t *win)
 {
     struct rtgui_event_win_destroy edestroy;
 
+#ifdef RTGUI_USING_ASYNC_ACK
+    /* take the acks, the window is in server if the create succeeded */
+    if (win->create_ack != RT_NULL)
+    {
+        if (rtgui_ack_wait(win->create_ack) == RT_EOK)
+            win->flag |= RTGUI_WIN_FLAG_CONNECTED;
+        win->create_ack = RT_NULL;
+    }
+    if (win->show_ack != RT_NULL)
+    {
+        rtgui_ack_wait(win->show_ack);
+        win->show_ack = RT_NULL;
+    }
+#endif
+
     if (win->flag & RTGUI_WIN_FLAG_CONNECTED)
     {
         /* destroy in server */
@@ -94,6 +125,26 @@ static void _rtgui_win_destructor(rtgui_win_t *win)
     rtgui_region_fini(&win->outer_clip);
     /* release external clip info */
     win->drawing = 0;
+
+#ifdef RTGUI_USING_DEFERRED_PAINT
+    if (win->dirty_count != 0)
+    {
+        struct rtgui_win **pwin;
+
+        /* unlink from application */
+        for (pwin = &win->app->dirty_wins; *pwin != RT_NULL; pwin = &(*pwin)->dirty_next)
+        {
+            if (*pwin == win)
+            {
+                *pwin = win->dirty_next;
+                break;
+            }
+        }
+        /* the children are not painted any more */
+        win->dirty_count = 0;
+    }
+    rtgui_region_fini(&win->dirty);
+#endif
 }
 
 static rt_bool_t _rtgui_win_create_in_server(struct rtgui_win *win)
@@ -128,10 +179,10 @@ DEFINE_CLASS_TYPE(win, "win",
                   _rtgui_win_destructor,
                   sizeof(struct rtgui_win));
 
-rtgui_win_t *rtgui_win_create(struct rtgui_win *parent_window,
-                              const char *title,
-                              rtgui_rect_t *rect,
-                              rt_uint16_t style)
+static rtgui_win_t *_rtgui_win_create(struct rtgui_win *parent_window,
+                                      const char *title,
+                                      rtgui_rect_t *rect,
+                                      rt_uint16_t style)
 {
     struct rtgui_win *win;
 
@@ -185,18 +236,80 @@ rtgui_win_t *rtgui_win_create(struct rtgui_win *parent_window,
         win->outer_extent = *rect;
     }
 
-    if (_rtgui_win_create_in_server(win) == RT_FALSE)
-    {
-        goto __on_err;
-    }
     return win;
 
 __on_err:
     rtgui_widget_destroy(RTGUI_WIDGET(win));
     return RT_NULL;
 }
+
+rtgui_win_t *rtgui_win_create(struct rtgui_win *parent_window,
+                              const char *title,
+                              rtgui_rect_t *rect,
+                              rt_uint16_t style)
+{
+    struct rtgui_win *win;
+
+    win = _rtgui_win_create(parent_window, title, rect, style);
+    if (win == RT_NULL)
+        return RT_NULL;
+
+    if (_rtgui_win_create_in_server(win) == RT_FALSE)
+    {
+        rtgui_widget_destroy(RTGUI_WIDGET(win));
+        return RT_NULL;
+    }
+    return win;
+}
 RTM_EXPORT(rtgui_win_create);
 
+#ifdef RTGUI_USING_ASYNC_ACK
+static rt_err_t _rtgui_win_create_in_server_async(struct rtgui_win *win)
+{
+    rt_err_t r;
+    struct rtgui_event_win_create ecreate;
+
+    RTGUI_EVENT_WIN_CREATE_INIT(&ecreate);
+    ecreate.parent_window = win->parent_window;
+    ecreate.wid           = win;
+    ecreate.parent.user   = win->style;
+
+    r = rtgui_server_post_event_async(RTGUI_EVENT(&ecreate),
+                                      sizeof(struct rtgui_event_win_create),
+                                      &win->create_ack);
+    if (r == -RT_EBUSY)
+    {
+        /* no free ack channel, create it synchronously */
+        if (_rtgui_win_create_in_server(win) == RT_FALSE)
+            return -RT_ERROR;
+        return RT_EOK;
+    }
+
+    return r;
+}
+
+rtgui_win_t *rtgui_win_create_async(struct rtgui_win *parent_window,
+                                    const char *title,
+                                    rtgui_rect_t *rect,
+                                    rt_uint16_t style)
+{
+    struct rtgui_win *win;
+
+    win = _rtgui_win_create(parent_window, title, rect, style);
+    if (win == RT_NULL)
+        return RT_NULL;
+
+    if (_rtgui_win_create_in_server_async(win) != RT_EOK)
+    {
+        rt_kprintf("create win: %s failed\n", win->title);
+        rtgui_widget_destroy(RTGUI_WIDGET(win));
+        return RT_NULL;
+    }
+    return win;
+}
+RTM_EXPORT(rtgui_win_create_async);
+#endif
+
 rtgui_win_t *rtgui_mainwin_create(struct rtgui_win *parent_window, const char *title, rt_uint16_t style)
 {
     struct rtgui_rect rect;
@@ -284,6 +397,22 @@ rt_bool_t rtgui_win_close(struct rtgui_win *win)
 }
 RTM_EXPORT(rtgui_win_close);
 
+/* the server has shown the window */
+static void _rtgui_win_shown(struct rtgui_win *win)
+{
+    struct rtgui_app *app;
+
+    if (win->focused_widget == RT_NULL)
+        rtgui_widget_focus(RTGUI_WIDGET(win));
+
+    app = win->app;
+    RT_ASSERT(app != RT_NULL);
+
+    /* set main window */
+    if (app->main_object == RT_NULL)
+        rtgui_app_set_main_win(app, win);
+}
+
 rt_base_t rtgui_win_show(struct rtgui_win *win, rt_bool_t is_modal)
 {
     rt_base_t exit_code = -1;
@@ -296,6 +425,10 @@ rt_base_t rtgui_win_show(struct rtgui_win *win, rt_bool_t is_modal)
     if (win == RT_NULL)
         return exit_code;
 
+#ifdef RTGUI_USING_ASYNC_ACK
+    rtgui_win_wait(win);
+#endif
+
     win->flag &= ~RTGUI_WIN_FLAG_CLOSED;
     win->flag &= ~RTGUI_WIN_FLAG_CB_PRESSED;
 
@@ -317,16 +450,9 @@ rt_base_t rtgui_win_show(struct rtgui_win *win, rt_bool_t is_modal)
         return exit_code;
     }
 
-    if (win->focused_widget == RT_NULL)
-        rtgui_widget_focus(RTGUI_WIDGET(win));
+    _rtgui_win_shown(win);
 
     app = win->app;
-    RT_ASSERT(app != RT_NULL);
-
-    /* set main window */
-    if (app->main_object == RT_NULL)
-        rtgui_app_set_main_win(app, win);
-
     if (is_modal == RT_TRUE)
     {
         struct rtgui_event_win_modal_enter emodal;
@@ -355,6 +481,90 @@ rt_base_t rtgui_win_show(struct rtgui_win *win, rt_bool_t is_modal)
 }
 RTM_EXPORT(rtgui_win_show);
 
+#ifdef RTGUI_USING_ASYNC_ACK
+rt_err_t rtgui_win_show_async(struct rtgui_win *win)
+{
+    rt_err_t r;
+    struct rtgui_event_win_show eshow;
+
+    RT_ASSERT(win != RT_NULL);
+
+    /* the show of last time is not acked yet */
+    if (win->show_ack != RT_NULL)
+        return RT_EOK;
+
+    win->flag &= ~RTGUI_WIN_FLAG_CLOSED;
+    win->flag &= ~RTGUI_WIN_FLAG_CB_PRESSED;
+
+    /* the server handles the create before the show */
+    if (!(win->flag & RTGUI_WIN_FLAG_CONNECTED) && win->create_ack == RT_NULL)
+    {
+        r = _rtgui_win_create_in_server_async(win);
+        if (r != RT_EOK)
+            return r;
+    }
+
+    /* set window unhidden before notify the server */
+    rtgui_widget_show(RTGUI_WIDGET(win));
+
+    RTGUI_EVENT_WIN_SHOW_INIT(&eshow);
+    eshow.wid = win;
+    r = rtgui_server_post_event_async(RTGUI_EVENT(&eshow),
+                                      sizeof(struct rtgui_event_win_show),
+                                      &win->show_ack);
+    if (r == -RT_EBUSY)
+    {
+        /* no free ack channel, show it synchronously */
+        r = rtgui_win_wait(win);
+        if (r == RT_EOK)
+            r = rtgui_server_post_event_sync(RTGUI_EVENT(&eshow),
+                                             sizeof(struct rtgui_event_win_show));
+        if (r == RT_EOK)
+            _rtgui_win_shown(win);
+    }
+
+    if (r != RT_EOK)
+        rtgui_widget_hide(RTGUI_WIDGET(win));
+    return r;
+}
+RTM_EXPORT(rtgui_win_show_async);
+
+rt_err_t rtgui_win_wait(struct rtgui_win *win)
+{
+    rt_err_t r = RT_EOK;
+
+    RT_ASSERT(win != RT_NULL);
+
+    if (win->create_ack != RT_NULL)
+    {
+        if (rtgui_ack_wait(win->create_ack) == RT_EOK)
+            win->flag |= RTGUI_WIN_FLAG_CONNECTED;
+        else
+        {
+            rt_kprintf("create win: %s failed\n", win->title);
+            r = -RT_ERROR;
+        }
+        win->create_ack = RT_NULL;
+    }
+
+    if (win->show_ack != RT_NULL)
+    {
+        if (rtgui_ack_wait(win->show_ack) == RT_EOK && r == RT_EOK)
+            _rtgui_win_shown(win);
+        else
+        {
+            /* It could not be shown if a parent window is hidden. */
+            rtgui_widget_hide(RTGUI_WIDGET(win));
+            r = -RT_ERROR;
+        }
+        win->show_ack = RT_NULL;
+    }
+
+    return r;
+}
+RTM_EXPORT(rtgui_win_wait);
+#endif
+
 void rtgui_win_end_modal(struct rtgui_win *win, rtgui_modal_code_t modal_code)
 {
     if (win == RT_NULL || !(win->flag & RTGUI_WIN_FLAG_MODAL))
@@ -371,6 +581,10 @@ void rtgui_win_hide(struct rtgui_win *win)
 {
     RT_ASSERT(win != RT_NULL);
 
+#ifdef RTGUI_USING_ASYNC_ACK
+    rtgui_win_wait(win);
+#endif
+
     if (!RTGUI_WIDGET_IS_HIDE(win) &&
             win->flag & RTGUI_WIN_FLAG_CONNECTED)
     {
@@ -423,6 +637,10 @@ void rtgui_win_move(struct rtgui_win *win, int x, int y)
     if (win == RT_NULL)
         return;
 
+#ifdef RTGUI_USING_ASYNC_ACK
+    rtgui_win_wait(win);
+#endif
+
     if (win->_title_wgt)
     {
         wgt = RTGUI_WIDGET(win->_title_wgt);
@@ -488,10 +706,16 @@ static rt_bool_t rtgui_win_ondraw(struct rtgui_win *win)
     return RT_FALSE;
 }
 
+#ifdef RTGUI_USING_LAZY_CLIP
+static rt_uint32_t _win_clip_generation = 0;
+#endif
+
 void rtgui_win_update_clip(struct rtgui_win *win)
 {
+#ifndef RTGUI_USING_LAZY_CLIP
     struct rtgui_container *cnt;
     struct rtgui_list_node *node;
+#endif
 
     if (win == RT_NULL)
         return;
@@ -518,6 +742,10 @@ void rtgui_win_update_clip(struct rtgui_win *win)
         rtgui_region_copy(&RTGUI_WIDGET(win)->clip, &win->outer_clip);
     }
 
+#ifdef RTGUI_USING_LAZY_CLIP
+    /* the widget clips are computed when they begin drawing */
+    win->clip_gen = ++_win_clip_generation;
+#else
     /* update the clip info of each child */
     cnt = RTGUI_CONTAINER(win);
     rtgui_list_foreach(node, &(cnt->children))
@@ -526,8 +754,64 @@ void rtgui_win_update_clip(struct rtgui_win *win)
 
         rtgui_widget_update_clip(child);
     }
+#endif
 }
 
+#ifdef RTGUI_USING_DEFERRED_PAINT
+void rtgui_win_paint_dirty(struct rtgui_win *win)
+{
+    int index, count;
+    rtgui_region_t dirty, clip;
+    rtgui_widget_t *widget, *parent;
+    rtgui_widget_t *widgets[RTGUI_WIN_DIRTY_WIDGETS];
+
+    RT_ASSERT(win != RT_NULL);
+
+    /* take the dirty state, the invalidation in painting goes to next pass */
+    count = 0;
+    for (index = 0; index < win->dirty_count; index ++)
+    {
+        widget = win->dirty_widgets[index];
+
+        /* the dirty parent paints the widget */
+        for (parent = widget->parent; parent != RT_NULL; parent = parent->parent)
+        {
+            if (parent->flag & RTGUI_WIDGET_FLAG_PAINT_DIRTY)
+                break;
+        }
+        if (parent == RT_NULL)
+            widgets[count ++] = widget;
+    }
+    for (index = 0; index < win->dirty_count; index ++)
+        win->dirty_widgets[index]->flag &= ~RTGUI_WIDGET_FLAG_PAINT_DIRTY;
+    win->dirty_count = 0;
+
+    rtgui_region_init(&dirty);
+    rtgui_region_copy(&dirty, &win->dirty);
+    rtgui_region_empty(&win->dirty);
+
+    rtgui_region_init(&clip);
+    for (index = 0; index < count; index ++)
+    {
+        widget = widgets[index];
+
+#ifdef RTGUI_USING_LAZY_CLIP
+        /* begin_drawing keeps the valid clip which is narrowed below */
+        rtgui_widget_validate_clip(widget);
+#endif
+        /* paint the widget in the dirty region only */
+        rtgui_region_copy(&clip, &widget->clip);
+        rtgui_region_intersect(&widget->clip, &widget->clip, &dirty);
+        if (rtgui_region_not_empty(&widget->clip))
+            rtgui_widget_update(widget);
+        rtgui_region_copy(&widget->clip, &clip);
+    }
+    rtgui_region_fini(&clip);
+    rtgui_region_fini(&dirty);
+}
+RTM_EXPORT(rtgui_win_paint_dirty);
+#endif
+
 static rt_bool_t _win_handle_mouse_btn(struct rtgui_win *win, struct rtgui_event *eve)
 {
     /* check whether has widget which handled mouse event before.
@@ -738,6 +1022,10 @@ void rtgui_win_set_rect(rtgui_win_t *win, rtgui_rect_t *rect)
 
     if (win == RT_NULL || rect == RT_NULL) return;
 
+#ifdef RTGUI_USING_ASYNC_ACK
+    rtgui_win_wait(win);
+#endif
+
     RTGUI_WIDGET(win)->extent = *rect;
 
     if (win->flag & RTGUI_WIN_FLAG_CONNECTED)
@@ -747,11 +1035,41 @@ void rtgui_win_set_rect(rtgui_win_t *win, rtgui_rect_t *rect)
         event.wid = win;
         event.rect = *rect;
 
+#ifdef RTGUI_USING_COMPOSITOR
+        /* server replaces the surface, wait for it before drawing again */
+        rtgui_server_post_event_sync(&(event.parent), sizeof(struct rtgui_event_win_resize));
+#else
         rtgui_server_post_event(&(event.parent), sizeof(struct rtgui_event_win_resize));
+#endif
     }
 }
 RTM_EXPORT(rtgui_win_set_rect);
 
+#ifdef RTGUI_USING_COMPOSITOR
+void rtgui_win_set_alpha(rtgui_win_t *win, rt_uint8_t alpha)
+{
+    struct rtgui_event_update_end eend;
+
+    if (win == RT_NULL || win->alpha == alpha) return;
+
+#ifdef RTGUI_USING_ASYNC_ACK
+    rtgui_win_wait(win);
+#endif
+
+    win->alpha = alpha;
+
+    if (win->flag & RTGUI_WIN_FLAG_CONNECTED && !RTGUI_WIDGET_IS_HIDE(win))
+    {
+        /* let server compose the window again */
+        RTGUI_EVENT_UPDATE_END_INIT(&eend);
+        eend.rect = win->outer_extent;
+        eend.wid = win;
+        rtgui_server_post_event(&(eend.parent), sizeof(eend));
+    }
+}
+RTM_EXPORT(rtgui_win_set_alpha);
+#endif
+
 void rtgui_win_set_onactivate(rtgui_win_t *win, rtgui_event_handler_ptr handler)
 {
     if (win != RT_NULL)
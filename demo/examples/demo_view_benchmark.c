@@ -1,6 +1,7 @@
 #include <stdlib.h>
 #include <rtgui/dc.h>
 #include <rtgui/dc_hw.h>
+#include <rtgui/driver.h>
 #include <rtgui/rtgui_system.h>
 #include <rtgui/widgets/container.h>
 #include "demo_view.h"
@@ -52,7 +53,10 @@ void _onidle(struct rtgui_object *object, rtgui_event_t *event)
     if(rt_tick_get()-ticks >= RT_TICK_PER_SECOND)
     {
         char buf[16];
-        sprintf(buf, "%.2f", (double)area/(800*480));
+        struct rtgui_graphic_driver *driver = rtgui_graphic_driver_get_default();
+
+        /* screens filled per second */
+        sprintf(buf, "%.2f", (double)area/(driver->width * driver->height));
         rt_kprintf("frames per second: %s fps\n", buf);
         area = 0;
         ticks = rt_tick_get();
@@ -0,0 +1,73 @@
+/*
+ * Benchmarks of the drawing and event paths.
+ *
+ * The benchmark window covers the whole screen. All the cases are run in the
+ * application thread on the first idle of the event loop and print their
+ * result to the console.
+ */
+#include <rtthread.h>
+
+#include <rtgui/rtgui.h>
+#include <rtgui/rtgui_app.h>
+#include <rtgui/driver.h>
+#include <rtgui/widgets/window.h>
+
+#include "bench.h"
+
+static struct rtgui_win *win;
+
+static void _bench_onidle(struct rtgui_object *object, struct rtgui_event *event)
+{
+    /* run only once */
+    rtgui_app_set_onidle(rtgui_app_self(), RT_NULL);
+
+    bench_fill_rect(win);
+    bench_fill_polygon(win);
+    bench_draw_text(win);
+    bench_invalidate(win);
+    bench_dc_buffer();
+    bench_blit_line();
+    bench_blit_alpha();
+    bench_event_ring();
+    bench_event_lanes();
+    bench_win_open();
+    bench_region();
+    bench_object_id();
+    bench_type_check(win);
+
+    rt_kprintf("benchmark done.\n");
+}
+
+static void bench_thread_entry(void *parameter)
+{
+    struct rtgui_app *app;
+    struct rtgui_rect rect;
+
+    app = rtgui_app_create("bench");
+    RT_ASSERT(app != RT_NULL);
+
+    rtgui_graphic_driver_get_rect(RT_NULL, &rect);
+    win = rtgui_win_create(RT_NULL, "bench", &rect,
+                           RTGUI_WIN_STYLE_NO_BORDER | RTGUI_WIN_STYLE_NO_TITLE);
+    RT_ASSERT(win != RT_NULL);
+
+    rtgui_win_show(win, RT_FALSE);
+
+    rtgui_app_set_onidle(app, _bench_onidle);
+    rtgui_app_run(app);
+
+    rtgui_win_destroy(win);
+    rtgui_app_destroy(app);
+}
+
+int rt_application_init()
+{
+    rt_thread_t tid;
+
+    tid = rt_thread_create("bench", bench_thread_entry, RT_NULL,
+                           4096, 20, 20);
+    if (tid != RT_NULL)
+        rt_thread_startup(tid);
+
+    return 0;
+}
@@ -0,0 +1,25 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <rtthread.h>
+#include <rtgui/rtgui.h>
+#include <rtgui/widgets/window.h>
+
+/* elapsed milliseconds since tick */
+#define BENCH_MS_SINCE(tick)    ((rt_tick_get() - (tick)) * 1000 / RT_TICK_PER_SECOND)
+
+void bench_fill_rect(struct rtgui_win *win);
+void bench_fill_polygon(struct rtgui_win *win);
+void bench_draw_text(struct rtgui_win *win);
+void bench_invalidate(struct rtgui_win *win);
+void bench_dc_buffer(void);
+void bench_blit_line(void);
+void bench_blit_alpha(void);
+void bench_event_ring(void);
+void bench_event_lanes(void);
+void bench_win_open(void);
+void bench_region(void);
+void bench_object_id(void);
+void bench_type_check(struct rtgui_win *win);
+
+#endif
@@ -0,0 +1,105 @@
+/*
+ * Alpha blending of rtgui_blit: MPixels/s of 565 surface alpha, ARGB8888 to
+ * 565 and ARGB8888 to ARGB8888, with sources of mixed, transparent and
+ * opaque pixels.
+ */
+#include <rtgui/blit.h>
+#include <rtgui/rtgui_system.h>
+
+#include "bench.h"
+
+#define ALPHA_W         256
+#define ALPHA_H         64
+#define ALPHA_LOOPS     50
+
+enum
+{
+    ALPHA_MIXED,
+    ALPHA_TRANSPARENT,
+    ALPHA_OPAQUE,
+};
+
+static const char *_alpha_name[] = {"mixed", "transparent", "opaque"};
+
+/* premultiplied ARGB8888 source */
+static void _fill_argb(rt_uint32_t *pixel, int type)
+{
+    int index;
+    rt_uint32_t a, c;
+
+    for (index = 0; index < ALPHA_W * ALPHA_H; index ++)
+    {
+        if (type == ALPHA_TRANSPARENT) a = 0;
+        else if (type == ALPHA_OPAQUE) a = 255;
+        else a = (index * 13) & 0xFF;
+
+        c = (index * 7) & 0xFF;
+        c = c * a / 255;
+        pixel[index] = a << 24 | c << 16 | c << 8 | c;
+    }
+}
+
+static rt_uint32_t _blit_rate(rt_uint8_t *dst, rt_uint8_t dst_fmt,
+                              rt_uint8_t *src, rt_uint8_t src_fmt, rt_uint8_t alpha)
+{
+    int loop;
+    rt_tick_t tick;
+    rt_uint32_t ms;
+    struct rtgui_blit_info info;
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < ALPHA_LOOPS; loop ++)
+    {
+        rt_memset(&info, 0, sizeof(info));
+        info.a = alpha;
+        info.src = src;
+        info.src_fmt = src_fmt;
+        info.src_w = ALPHA_W;
+        info.src_h = ALPHA_H;
+        info.src_pitch = ALPHA_W * rtgui_color_get_bpp(src_fmt);
+        info.dst = dst;
+        info.dst_fmt = dst_fmt;
+        info.dst_w = ALPHA_W;
+        info.dst_h = ALPHA_H;
+        info.dst_pitch = ALPHA_W * rtgui_color_get_bpp(dst_fmt);
+
+        rtgui_blit(&info);
+    }
+    ms = BENCH_MS_SINCE(tick);
+    if (ms == 0) ms = 1;
+
+    return (rt_uint32_t)ALPHA_W * ALPHA_H * ALPHA_LOOPS / 1000 / ms;
+}
+
+void bench_blit_alpha(void)
+{
+    int type;
+    rt_uint8_t *src, *dst;
+
+    src = rtgui_malloc(ALPHA_W * ALPHA_H * 4);
+    dst = rtgui_malloc(ALPHA_W * ALPHA_H * 4);
+    if (src == RT_NULL || dst == RT_NULL)
+        goto __exit;
+
+    rt_memset(dst, 0x5A, ALPHA_W * ALPHA_H * 4);
+    rt_kprintf("blit alpha, %dx%d x %d (MPixels/s):\n", ALPHA_W, ALPHA_H, ALPHA_LOOPS);
+
+    rt_memset(src, 0xA5, ALPHA_W * ALPHA_H * 2);
+    rt_kprintf("  565->565 alpha 100: %4d\n",
+               _blit_rate(dst, RTGRAPHIC_PIXEL_FORMAT_RGB565,
+                          src, RTGRAPHIC_PIXEL_FORMAT_RGB565, 100));
+
+    for (type = ALPHA_MIXED; type <= ALPHA_OPAQUE; type ++)
+    {
+        _fill_argb((rt_uint32_t *)src, type);
+        rt_kprintf("  %-11s 8888->565 %4d, 8888->8888 %4d\n", _alpha_name[type],
+                   _blit_rate(dst, RTGRAPHIC_PIXEL_FORMAT_RGB565,
+                              src, RTGRAPHIC_PIXEL_FORMAT_ARGB888, 255),
+                   _blit_rate(dst, RTGRAPHIC_PIXEL_FORMAT_ARGB888,
+                              src, RTGRAPHIC_PIXEL_FORMAT_ARGB888, 255));
+    }
+
+__exit:
+    if (src != RT_NULL) rtgui_free(src);
+    if (dst != RT_NULL) rtgui_free(dst);
+}
@@ -0,0 +1,73 @@
+/*
+ * Pixel format line converters: MPixels/s of the generic converter and the
+ * one installed by rtgui_blit_line_init, for each 565/888/ARGB8888 pair.
+ */
+#include <rtgui/blit.h>
+#include <rtgui/rtgui_system.h>
+
+#include "bench.h"
+
+#define LINE_PIXELS     1024
+#define LINE_LOOPS      2000
+
+/* MPixels/s of converting LINE_LOOPS lines */
+static rt_uint32_t _blit_line_rate(rtgui_blit_line_func func, int src_bpp,
+                                   rt_uint8_t *dst, rt_uint8_t *src)
+{
+    int loop;
+    rt_tick_t tick;
+    rt_uint32_t ms;
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < LINE_LOOPS; loop ++)
+        func(dst, src, LINE_PIXELS * src_bpp);
+    ms = BENCH_MS_SINCE(tick);
+    if (ms == 0) ms = 1;
+
+    return (rt_uint32_t)LINE_PIXELS * LINE_LOOPS / 1000 / ms;
+}
+
+void bench_blit_line(void)
+{
+    int index;
+    rt_uint8_t *src, *dst;
+    const static struct
+    {
+        const char *name;
+        int dst_bpp, src_bpp;
+    } pairs[] =
+    {
+        {"565->888 ", 3, 2},
+        {"565->8888", 4, 2},
+        {"888->565 ", 2, 3},
+        {"8888->565", 2, 4},
+        {"888->8888", 4, 3},
+        {"8888->888", 3, 4},
+    };
+
+    src = rtgui_malloc(LINE_PIXELS * 4);
+    dst = rtgui_malloc(LINE_PIXELS * 4);
+    if (src == RT_NULL || dst == RT_NULL)
+        goto __exit;
+
+    for (index = 0; index < LINE_PIXELS * 4; index ++)
+        src[index] = (rt_uint8_t)(index * 7);
+
+    rt_kprintf("blit line, %d pixels x %d lines (MPixels/s):\n",
+               LINE_PIXELS, LINE_LOOPS);
+    for (index = 0; index < sizeof(pairs) / sizeof(pairs[0]); index ++)
+    {
+        rtgui_blit_line_func generic, func;
+
+        generic = rtgui_blit_line_get_generic(pairs[index].dst_bpp, pairs[index].src_bpp);
+        func = rtgui_blit_line_get(pairs[index].dst_bpp, pairs[index].src_bpp);
+
+        rt_kprintf("  %s generic %4d, installed %4d\n", pairs[index].name,
+                   _blit_line_rate(generic, pairs[index].src_bpp, dst, src),
+                   _blit_line_rate(func, pairs[index].src_bpp, dst, src));
+    }
+
+__exit:
+    if (src != RT_NULL) rtgui_free(src);
+    if (dst != RT_NULL) rtgui_free(dst);
+}
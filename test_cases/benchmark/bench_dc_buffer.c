@@ -0,0 +1,103 @@
+/*
+ * Buffer DC primitives: fill_rect and hline of the per-format engines,
+ * against the old path that switched on the pixel format for every pixel.
+ */
+#include <rtgui/dc.h>
+#include <rtgui/color.h>
+
+#include "bench.h"
+
+#define BUFFER_W        240
+#define BUFFER_H        320
+#define BUFFER_LOOPS    50
+
+/* the old path: the pixel format is checked for each pixel */
+static void _fill_by_pixel(struct rtgui_dc_buffer *dst, rtgui_rect_t *rect)
+{
+    int x, y;
+    rt_uint8_t *ptr;
+    rtgui_color_t c = dst->gc.background;
+    int bpp = rtgui_color_get_bpp(dst->pixel_format);
+
+    for (y = rect->y1; y < rect->y2; y ++)
+    {
+        ptr = dst->pixel + y * dst->pitch + rect->x1 * bpp;
+        for (x = rect->x1; x < rect->x2; x ++)
+        {
+            switch (dst->pixel_format)
+            {
+            case RTGRAPHIC_PIXEL_FORMAT_RGB565:
+                *(rt_uint16_t *)ptr = rtgui_color_to_565(c);
+                break;
+            case RTGRAPHIC_PIXEL_FORMAT_BGR565:
+                *(rt_uint16_t *)ptr = rtgui_color_to_565p(c);
+                break;
+            case RTGRAPHIC_PIXEL_FORMAT_RGB888:
+                ptr[0] = RTGUI_RGB_B(c);
+                ptr[1] = RTGUI_RGB_G(c);
+                ptr[2] = RTGUI_RGB_R(c);
+                break;
+            case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
+                *(rt_uint32_t *)ptr = c;
+                break;
+            }
+            ptr += bpp;
+        }
+    }
+}
+
+void bench_dc_buffer(void)
+{
+    int index, loop, y;
+    rt_tick_t tick;
+    rt_uint32_t ms_pixel, ms_fill, ms_hline;
+    rtgui_rect_t rect;
+    struct rtgui_dc *dc;
+    const static struct
+    {
+        const char *name;
+        rt_uint8_t format;
+    } formats[] =
+    {
+        {"RGB565  ", RTGRAPHIC_PIXEL_FORMAT_RGB565},
+        {"BGR565  ", RTGRAPHIC_PIXEL_FORMAT_BGR565},
+        {"RGB888  ", RTGRAPHIC_PIXEL_FORMAT_RGB888},
+        {"ARGB8888", RTGRAPHIC_PIXEL_FORMAT_ARGB888},
+    };
+
+    /* a rect narrower than the buffer, so rows are not contiguous */
+    rect.x1 = 3;
+    rect.y1 = 0;
+    rect.x2 = BUFFER_W - 3;
+    rect.y2 = BUFFER_H;
+
+    for (index = 0; index < sizeof(formats) / sizeof(formats[0]); index ++)
+    {
+        dc = rtgui_dc_buffer_create_pixformat(formats[index].format, BUFFER_W, BUFFER_H);
+        if (dc == RT_NULL)
+            continue;
+        RTGUI_DC_BC(dc) = RTGUI_RGB(0x12, 0x34, 0x56);
+        RTGUI_DC_FC(dc) = RTGUI_RGB(0x12, 0x34, 0x56);
+
+        tick = rt_tick_get();
+        for (loop = 0; loop < BUFFER_LOOPS; loop ++)
+            _fill_by_pixel((struct rtgui_dc_buffer *)dc, &rect);
+        ms_pixel = BENCH_MS_SINCE(tick);
+
+        tick = rt_tick_get();
+        for (loop = 0; loop < BUFFER_LOOPS; loop ++)
+            rtgui_dc_fill_rect(dc, &rect);
+        ms_fill = BENCH_MS_SINCE(tick);
+
+        tick = rt_tick_get();
+        for (loop = 0; loop < BUFFER_LOOPS; loop ++)
+            for (y = rect.y1; y < rect.y2; y ++)
+                rtgui_dc_draw_hline(dc, rect.x1, rect.x2, y);
+        ms_hline = BENCH_MS_SINCE(tick);
+
+        rtgui_dc_destory(dc);
+
+        rt_kprintf("dc_buffer %s, %d loops: by pixel %d ms, fill_rect %d ms, hline %d ms\n",
+                   formats[index].name, BUFFER_LOOPS, ms_pixel, ms_fill, ms_hline);
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ * Draw text on client DC: the glyphs go as 1bpp masks through blit_mono,
+ * against drawing the same masks point by point.
+ */
+#include <rtgui/dc.h>
+#include <rtgui/font.h>
+#include <rtgui/widgets/widget.h>
+
+#include "bench.h"
+
+#define TEXT_LOOPS      20
+
+static const char _text[] = "The quick brown fox jumps over the lazy dog. 0123456789";
+
+/* the old path: one point for each bit of mask */
+static void _mono_by_point(struct rtgui_dc *dc, int x, int y, int w, int h,
+                           const rt_uint8_t *mask, int pitch)
+{
+    int i, j;
+
+    for (i = 0; i < h; i ++)
+        for (j = 0; j < w; j ++)
+            if (mask[i * pitch + (j >> 3)] & (0x80 >> (j & 0x07)))
+                rtgui_dc_draw_point(dc, x + j, y + i);
+}
+
+void bench_draw_text(struct rtgui_win *win)
+{
+    int loop, y;
+    rt_tick_t tick;
+    rt_uint32_t ms_text, ms_point, ms_mono;
+    rtgui_rect_t rect, line;
+    struct rtgui_dc *dc;
+    /* a 16x16 glyph of stripes */
+    static const rt_uint8_t glyph[32] =
+    {
+        0xF0, 0x0F, 0xF0, 0x0F, 0xCC, 0x33, 0xCC, 0x33,
+        0xAA, 0x55, 0xAA, 0x55, 0xFF, 0x00, 0x00, 0xFF,
+        0xF0, 0x0F, 0xF0, 0x0F, 0xCC, 0x33, 0xCC, 0x33,
+        0xAA, 0x55, 0xAA, 0x55, 0xFF, 0x00, 0x00, 0xFF,
+    };
+
+    dc = rtgui_dc_begin_drawing(RTGUI_WIDGET(win));
+    if (dc == RT_NULL)
+        return;
+
+    rtgui_dc_get_rect(dc, &rect);
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < TEXT_LOOPS; loop ++)
+    {
+        line = rect;
+        for (y = rect.y1; y + 16 < rect.y2; y += 16)
+        {
+            line.y1 = y;
+            line.y2 = y + 16;
+            rtgui_dc_draw_text(dc, _text, &line);
+        }
+    }
+    ms_text = BENCH_MS_SINCE(tick);
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < TEXT_LOOPS; loop ++)
+        for (y = rect.y1; y + 16 < rect.y2; y += 16)
+            _mono_by_point(dc, rect.x1, y, 16, 16, glyph, 2);
+    ms_point = BENCH_MS_SINCE(tick);
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < TEXT_LOOPS; loop ++)
+        for (y = rect.y1; y + 16 < rect.y2; y += 16)
+            rtgui_dc_blit_mono(dc, rect.x1, y, 16, 16, glyph, 2, RT_FALSE);
+    ms_mono = BENCH_MS_SINCE(tick);
+
+    rtgui_dc_end_drawing(dc);
+
+    rt_kprintf("draw_text, %d loops: text %d ms, glyph by point %d ms, by blit_mono %d ms\n",
+               TEXT_LOOPS, ms_text, ms_point, ms_mono);
+}
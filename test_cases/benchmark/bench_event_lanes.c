@@ -0,0 +1,80 @@
+/*
+ * Event lanes: a key queued behind more timers than the old lanes held. The
+ * application runs a nested event loop on LANE_TIMERS timer events and then
+ * one key event, all queued before it pulls, and prints when the key is
+ * handled. The input lane goes first, so the key should be the first one.
+ */
+#include <rtgui/event.h>
+#include <rtgui/rtgui_app.h>
+
+#include "bench.h"
+
+#ifdef RTGUI_USING_EVENT_LANES
+#define LANE_TIMERS     20
+
+static int _lane_timers;
+static int _lane_key_at;
+
+static rt_bool_t _lane_handler(struct rtgui_object *object, struct rtgui_event *event)
+{
+    if (event->type == RTGUI_EVENT_TIMER)
+    {
+        _lane_timers ++;
+    }
+    else if (event->type == RTGUI_EVENT_KBD)
+    {
+        _lane_key_at = _lane_timers;
+    }
+    else
+    {
+        /* not the events of the check */
+        return RT_FALSE;
+    }
+
+    if (_lane_timers == LANE_TIMERS && _lane_key_at >= 0)
+        rtgui_app_exit(RTGUI_APP(object), 0);
+
+    return RT_TRUE;
+}
+
+void bench_event_lanes(void)
+{
+    int index;
+    rt_tick_t tick;
+    struct rtgui_app *app = rtgui_app_self();
+    rtgui_event_handler_ptr handler;
+    struct rtgui_event_timer etimer;
+    struct rtgui_event_kbd ekbd;
+
+    RTGUI_EVENT_TIMER_INIT(&etimer);
+    etimer.timer = RT_NULL;
+    RTGUI_EVENT_KBD_INIT(&ekbd);
+    ekbd.wid = RT_NULL;
+    ekbd.type = RTGUI_KEYDOWN;
+    ekbd.key = RTGUIK_RETURN;
+    ekbd.mod = RTGUI_KMOD_NONE;
+    ekbd.unicode = 0;
+
+    _lane_timers = 0;
+    _lane_key_at = -1;
+
+    for (index = 0; index < LANE_TIMERS; index ++)
+        rtgui_send(app, &(etimer.parent), sizeof(etimer));
+    rtgui_send(app, &(ekbd.parent), sizeof(ekbd));
+
+    handler = RTGUI_OBJECT(app)->event_handler;
+    rtgui_object_set_event_handler(RTGUI_OBJECT(app), _lane_handler);
+    tick = rt_tick_get();
+    rtgui_app_run(app);
+    rtgui_object_set_event_handler(RTGUI_OBJECT(app), handler);
+
+    rt_kprintf("event lanes:\n");
+    rt_kprintf("  key behind %d timers handled after %d of them, %d ms%s\n",
+               LANE_TIMERS, _lane_key_at, BENCH_MS_SINCE(tick),
+               _lane_key_at == 0 ? "" : " (FAILED)");
+}
+#else
+void bench_event_lanes(void)
+{
+}
+#endif
@@ -0,0 +1,106 @@
+/*
+ * Event passing: events/s from a sender thread to the application thread
+ * through rt_mq and through the lock free event ring, both of 32 events of
+ * union rtgui_event_generic like the queue of application.
+ */
+#include <rtgui/event.h>
+#include <rtgui/event_ring.h>
+
+#include "bench.h"
+
+#define RING_EVENTS     20000
+#define RING_SIZE       32
+
+static rt_mq_t _bench_mq;
+static struct rtgui_event_ring _bench_ring;
+static struct rt_semaphore _bench_start;
+
+static void _sender_entry(void *parameter)
+{
+    int count;
+    rt_bool_t use_ring = (rt_bool_t)(rt_ubase_t)parameter;
+    struct rtgui_event_mouse event;
+
+    RTGUI_EVENT_MOUSE_MOTION_INIT(&event);
+    event.wid = RT_NULL;
+
+    rt_sem_take(&_bench_start, RT_WAITING_FOREVER);
+    for (count = 0; count < RING_EVENTS; )
+    {
+        event.x = count;
+        if (use_ring)
+        {
+            if (rtgui_event_ring_put(&_bench_ring, &(event.parent), sizeof(event)) != RT_EOK)
+            {
+                rt_thread_yield();
+                continue;
+            }
+        }
+        else
+        {
+            if (rt_mq_send(_bench_mq, &event, sizeof(event)) != RT_EOK)
+            {
+                rt_thread_yield();
+                continue;
+            }
+        }
+        count ++;
+    }
+}
+
+/* events/s of passing RING_EVENTS events from a new thread */
+static rt_uint32_t _event_rate(rt_bool_t use_ring)
+{
+    int count;
+    rt_tick_t tick;
+    rt_uint32_t ms;
+    rt_thread_t tid;
+    union rtgui_event_generic event;
+
+    tid = rt_thread_create("bsend", _sender_entry, (void *)(rt_ubase_t)use_ring,
+                           1024, 20, 5);
+    if (tid == RT_NULL)
+        return 0;
+    rt_thread_startup(tid);
+
+    tick = rt_tick_get();
+    rt_sem_release(&_bench_start);
+    for (count = 0; count < RING_EVENTS; count ++)
+    {
+        if (use_ring)
+            rtgui_event_ring_get(&_bench_ring, (rtgui_event_t *)&event,
+                                 sizeof(event), RT_WAITING_FOREVER);
+        else
+            rt_mq_recv(_bench_mq, &event, sizeof(event), RT_WAITING_FOREVER);
+    }
+    ms = BENCH_MS_SINCE(tick);
+    if (ms == 0) ms = 1;
+
+    return (rt_uint32_t)RING_EVENTS * 1000 / ms;
+}
+
+void bench_event_ring(void)
+{
+    rt_uint32_t mq_rate, ring_rate;
+
+    _bench_mq = rt_mq_create("bmq", sizeof(union rtgui_event_generic),
+                             RING_SIZE, RT_IPC_FLAG_FIFO);
+    if (_bench_mq == RT_NULL)
+        return;
+    if (rtgui_event_ring_init(&_bench_ring, "bring", RING_SIZE) != RT_EOK)
+    {
+        rt_mq_delete(_bench_mq);
+        return;
+    }
+    rt_sem_init(&_bench_start, "bstart", 0, RT_IPC_FLAG_FIFO);
+
+    mq_rate = _event_rate(RT_FALSE);
+    ring_rate = _event_rate(RT_TRUE);
+
+    rt_kprintf("event passing, %d events (events/s):\n", RING_EVENTS);
+    rt_kprintf("  rt_mq %8d, event ring %8d\n", mq_rate, ring_rate);
+
+    rt_sem_detach(&_bench_start);
+    rtgui_event_ring_fini(&_bench_ring);
+    rt_mq_delete(_bench_mq);
+}
@@ -0,0 +1,148 @@
+/*
+ * Fill polygon: the edge table filler against the old per-scanline
+ * intersection and qsort path, with star polygons of 10 to 1000 vertices.
+ */
+#include <math.h>
+#include <stdlib.h>
+
+#include <rtgui/dc.h>
+#include <rtgui/rtgui_system.h>
+#include <rtgui/widgets/widget.h>
+
+#include "bench.h"
+
+#define POLYGON_LOOPS   20
+
+static int _int_compare(const void *a, const void *b)
+{
+    return (*(const int *) a) - (*(const int *) b);
+}
+
+/* the old path: all the edges are intersected and sorted on each scanline */
+static void _fill_by_qsort(struct rtgui_dc *dc, const int *vx, const int *vy, int count)
+{
+    int i, y, xa, xb, miny, maxy;
+    int x1, y1, x2, y2, ind1, ind2, ints;
+    int *poly_ints;
+
+    poly_ints = (int *) rtgui_malloc(sizeof(int) * count);
+    if (poly_ints == RT_NULL) return;
+
+    miny = maxy = vy[0];
+    for (i = 1; i < count; i++)
+    {
+        if (vy[i] < miny) miny = vy[i];
+        else if (vy[i] > maxy) maxy = vy[i];
+    }
+
+    for (y = miny; y <= maxy; y++)
+    {
+        ints = 0;
+        for (i = 0; i < count; i++)
+        {
+            ind1 = i ? i - 1 : count - 1;
+            ind2 = i;
+            y1 = vy[ind1];
+            y2 = vy[ind2];
+            if (y1 < y2)
+            {
+                x1 = vx[ind1];
+                x2 = vx[ind2];
+            }
+            else if (y1 > y2)
+            {
+                y2 = vy[ind1];
+                y1 = vy[ind2];
+                x2 = vx[ind1];
+                x1 = vx[ind2];
+            }
+            else
+            {
+                continue;
+            }
+
+            if (((y >= y1) && (y < y2)) || ((y == maxy) && (y > y1) && (y <= y2)))
+                poly_ints[ints++] = ((65536 * (y - y1)) / (y2 - y1)) * (x2 - x1) + (65536 * x1);
+        }
+
+        qsort(poly_ints, ints, sizeof(int), _int_compare);
+
+        for (i = 0; i < ints; i += 2)
+        {
+            xa = poly_ints[i] + 1;
+            xa = (xa >> 16) + ((xa & 32768) >> 15);
+            xb = poly_ints[i + 1] - 1;
+            xb = (xb >> 16) + ((xb & 32768) >> 15);
+            rtgui_dc_draw_hline(dc, xa, xb, y);
+        }
+    }
+
+    rtgui_free(poly_ints);
+}
+
+/* a star with count vertices in rect */
+static void _make_star(int *vx, int *vy, int count, rtgui_rect_t *rect)
+{
+    int i, cx, cy, r;
+    double angle;
+
+    cx = (rect->x1 + rect->x2) / 2;
+    cy = (rect->y1 + rect->y2) / 2;
+    r = rtgui_rect_height(*rect) < rtgui_rect_width(*rect) ?
+        rtgui_rect_height(*rect) / 2 : rtgui_rect_width(*rect) / 2;
+
+    for (i = 0; i < count; i++)
+    {
+        angle = 2 * M_PI * i / count;
+        vx[i] = cx + (int)((i & 0x01 ? r / 2 : r) * cos(angle));
+        vy[i] = cy + (int)((i & 0x01 ? r / 2 : r) * sin(angle));
+    }
+}
+
+static void _polygon_bench(struct rtgui_dc *dc, rtgui_rect_t *rect, int count)
+{
+    int loop;
+    int *vx, *vy;
+    rt_tick_t tick;
+    rt_uint32_t ms_qsort, ms_edge;
+
+    vx = (int *) rtgui_malloc(sizeof(int) * count * 2);
+    if (vx == RT_NULL) return;
+    vy = vx + count;
+
+    _make_star(vx, vy, count, rect);
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < POLYGON_LOOPS; loop ++)
+        _fill_by_qsort(dc, vx, vy, count);
+    ms_qsort = BENCH_MS_SINCE(tick);
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < POLYGON_LOOPS; loop ++)
+        rtgui_dc_fill_polygon(dc, vx, vy, count);
+    ms_edge = BENCH_MS_SINCE(tick);
+
+    rt_kprintf("fill_polygon %4d vertices: qsort %5d ms, edge table %5d ms\n",
+               count, ms_qsort, ms_edge);
+
+    rtgui_free(vx);
+}
+
+void bench_fill_polygon(struct rtgui_win *win)
+{
+    rtgui_rect_t rect;
+    struct rtgui_dc *dc;
+
+    dc = rtgui_dc_begin_drawing(RTGUI_WIDGET(win));
+    if (dc == RT_NULL)
+        return;
+
+    rtgui_dc_get_rect(dc, &rect);
+
+    rt_kprintf("fill_polygon, %d loops:\n", POLYGON_LOOPS);
+    _polygon_bench(dc, &rect, 10);
+    _polygon_bench(dc, &rect, 100);
+    _polygon_bench(dc, &rect, 1000);
+
+    rtgui_dc_end_drawing(dc);
+}
@@ -0,0 +1,106 @@
+/*
+ * Fill rect on client DC: region-aware fill against the per-scanline hline
+ * path, with 1, 8 and 64 clip rects.
+ */
+#include <rtgui/dc.h>
+#include <rtgui/region.h>
+#include <rtgui/widgets/widget.h>
+
+#include "bench.h"
+
+#define FILL_LOOPS  100
+
+/* make the clip of widget to count vertical stripes */
+static void _set_stripe_clip(struct rtgui_widget *widget, int count)
+{
+    int index, width;
+    rtgui_rect_t rect;
+
+    rtgui_region_fini(&widget->clip);
+    rtgui_region_init(&widget->clip);
+    if (count == 1)
+    {
+        /* a clip smaller than extent, otherwise it gets a hardware DC */
+        rect = widget->extent;
+        rect.x2 -= 1;
+        rtgui_region_reset(&widget->clip, &rect);
+        return;
+    }
+
+    width = rtgui_rect_width(widget->extent) / (count * 2);
+    if (width == 0) width = 1;
+    for (index = 0; index < count; index ++)
+    {
+        rect = widget->extent;
+        rect.x1 = widget->extent.x1 + index * 2 * width;
+        rect.x2 = rect.x1 + width;
+        rtgui_region_union_rect(&widget->clip, &widget->clip, &rect);
+    }
+}
+
+/* the old path: one hline for each scanline */
+static void _fill_by_hline(struct rtgui_dc *dc, rtgui_rect_t *rect)
+{
+    int y;
+    rtgui_color_t fc;
+
+    fc = RTGUI_DC_FC(dc);
+    RTGUI_DC_FC(dc) = RTGUI_DC_BC(dc);
+    for (y = rect->y1; y < rect->y2; y ++)
+        rtgui_dc_draw_hline(dc, rect->x1, rect->x2, y);
+    RTGUI_DC_FC(dc) = fc;
+}
+
+static void _fill_bench(struct rtgui_widget *widget, int count)
+{
+    int loop;
+    rt_tick_t tick;
+    rt_uint32_t ms_hline, ms_rect;
+    rtgui_rect_t rect;
+    struct rtgui_dc *dc;
+
+    _set_stripe_clip(widget, count);
+
+    dc = rtgui_dc_begin_drawing(widget);
+    if (dc == RT_NULL)
+        return;
+
+    rtgui_dc_get_rect(dc, &rect);
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < FILL_LOOPS; loop ++)
+        _fill_by_hline(dc, &rect);
+    ms_hline = BENCH_MS_SINCE(tick);
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < FILL_LOOPS; loop ++)
+        rtgui_dc_fill_rect(dc, &rect);
+    ms_rect = BENCH_MS_SINCE(tick);
+
+    rtgui_dc_end_drawing(dc);
+
+    rt_kprintf("fill_rect %dx%d, %2d clip rects: hline %4d ms, rect %4d ms\n",
+               rtgui_rect_width(rect), rtgui_rect_height(rect),
+               rtgui_region_num_rects(&widget->clip), ms_hline, ms_rect);
+}
+
+void bench_fill_rect(struct rtgui_win *win)
+{
+    struct rtgui_widget *widget;
+    rtgui_region_t clip;
+
+    widget = RTGUI_WIDGET(win);
+
+    /* save the clip of window */
+    rtgui_region_init(&clip);
+    rtgui_region_copy(&clip, &widget->clip);
+
+    rt_kprintf("fill_rect, %d loops:\n", FILL_LOOPS);
+    _fill_bench(widget, 1);
+    _fill_bench(widget, 8);
+    _fill_bench(widget, 64);
+
+    /* restore the clip */
+    rtgui_region_copy(&widget->clip, &clip);
+    rtgui_region_fini(&clip);
+}
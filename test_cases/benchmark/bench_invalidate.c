@@ -0,0 +1,90 @@
+/*
+ * Deferred paint: INVALIDATE_SETS rtgui_label_set_text on a label of the
+ * benchmark window, painted once by rtgui_app_paint_dirty, against painting
+ * the label on each set like rtgui_widget_update. Prints the paints and the
+ * ms of both, the deferred path should paint once.
+ */
+#include <rtgui/rtgui_app.h>
+#include <rtgui/widgets/container.h>
+#include <rtgui/widgets/label.h>
+
+#include "bench.h"
+
+#ifdef RTGUI_USING_DEFERRED_PAINT
+#define INVALIDATE_SETS     100
+
+static int _paints;
+static rtgui_event_handler_ptr _label_handler;
+
+/* count the paints of label */
+static rt_bool_t _count_handler(struct rtgui_object *object, struct rtgui_event *event)
+{
+    if (event->type == RTGUI_EVENT_PAINT)
+        _paints ++;
+
+    return _label_handler(object, event);
+}
+
+void bench_invalidate(struct rtgui_win *win)
+{
+    int index;
+    char text[12];
+    rt_tick_t tick;
+    rt_uint32_t ms_update, ms_deferred;
+    int paints_update;
+    rtgui_rect_t rect;
+    struct rtgui_label *label;
+
+    label = rtgui_label_create("label");
+    if (label == RT_NULL)
+        return;
+    rect.x1 = 0; rect.y1 = 0;
+    rect.x2 = 120; rect.y2 = 20;
+    rtgui_widget_rect_to_device(RTGUI_WIDGET(win), &rect);
+    rtgui_widget_set_rect(RTGUI_WIDGET(label), &rect);
+    rtgui_container_add_child(RTGUI_CONTAINER(win), RTGUI_WIDGET(label));
+    rtgui_win_update_clip(win);
+
+    _label_handler = RTGUI_OBJECT(label)->event_handler;
+    rtgui_object_set_event_handler(RTGUI_OBJECT(label), _count_handler);
+
+    /* paint on each set */
+    _paints = 0;
+    tick = rt_tick_get();
+    for (index = 0; index < INVALIDATE_SETS; index ++)
+    {
+        rt_snprintf(text, sizeof(text), "%d", index);
+        rtgui_label_set_text(label, text);
+        rtgui_widget_update(RTGUI_WIDGET(label));
+    }
+    ms_update = BENCH_MS_SINCE(tick);
+    paints_update = _paints;
+    /* the invalidations are painted as well */
+    rtgui_app_paint_dirty(rtgui_app_self());
+
+    /* paint once for all the sets */
+    _paints = 0;
+    tick = rt_tick_get();
+    for (index = 0; index < INVALIDATE_SETS; index ++)
+    {
+        rt_snprintf(text, sizeof(text), "%d", index);
+        rtgui_label_set_text(label, text);
+    }
+    rtgui_app_paint_dirty(rtgui_app_self());
+    ms_deferred = BENCH_MS_SINCE(tick);
+
+    rt_kprintf("deferred paint (%d label sets):\n", INVALIDATE_SETS);
+    rt_kprintf("  path        paints  ms\n");
+    rt_kprintf("  update    %8d %4d\n", paints_update, ms_update);
+    rt_kprintf("  deferred  %8d %4d%s\n", _paints, ms_deferred,
+               _paints == 1 ? "" : " (FAILED)");
+
+    rtgui_container_remove_child(RTGUI_CONTAINER(win), RTGUI_WIDGET(label));
+    rtgui_label_destroy(label);
+    rtgui_win_update_clip(win);
+}
+#else
+void bench_invalidate(struct rtgui_win *win)
+{
+}
+#endif
@@ -0,0 +1,113 @@
+/*
+ * Object lookup by ID: lookups/ms of rtgui_container_get_object on a form of
+ * 10 to 500 labels in panels of 10, like a screen loaded with the IDs of its
+ * controls, against the old path that walked the children recursively.
+ */
+#include <rtgui/rtgui_object.h>
+#include <rtgui/widgets/container.h>
+#include <rtgui/widgets/label.h>
+
+#include "bench.h"
+
+#define ID_PANEL        10
+#define ID_BASE         1000
+#define ID_LOOKUPS      20000
+
+/* the old path: walk the children of container and the containers in it */
+static struct rtgui_object *_get_walk(struct rtgui_container *container, rt_uint32_t id)
+{
+    struct rtgui_list_node *node;
+    struct rtgui_object *object, *found;
+
+    rtgui_list_foreach(node, &(container->children))
+    {
+        object = RTGUI_OBJECT(rtgui_list_entry(node, struct rtgui_widget, sibling));
+        if (object->id == id)
+            return object;
+
+        if (RTGUI_IS_CONTAINER(object))
+        {
+            found = _get_walk(RTGUI_CONTAINER(object), id);
+            if (found)
+                return found;
+        }
+    }
+
+    return RT_NULL;
+}
+
+/* a form of count labels with the IDs from ID_BASE, ID_PANEL in a panel */
+static struct rtgui_container *_make_form(int count)
+{
+    int index;
+    struct rtgui_container *form, *panel = RT_NULL;
+    struct rtgui_label *label;
+
+    form = rtgui_container_create();
+    if (form == RT_NULL)
+        return RT_NULL;
+
+    for (index = 0; index < count; index ++)
+    {
+        if (index % ID_PANEL == 0)
+        {
+            panel = rtgui_container_create();
+            if (panel == RT_NULL)
+                break;
+            rtgui_container_add_child(form, RTGUI_WIDGET(panel));
+        }
+
+        label = rtgui_label_create("label");
+        if (label == RT_NULL)
+            break;
+        rtgui_object_set_id(RTGUI_OBJECT(label), ID_BASE + index);
+        rtgui_container_add_child(panel, RTGUI_WIDGET(label));
+    }
+
+    return form;
+}
+
+/* lookups/ms of the IDs in the form */
+static rt_uint32_t _lookup_rate(struct rtgui_container *form, int count, rt_bool_t walk)
+{
+    int index;
+    rt_uint32_t seed = 1, id, ms;
+    rt_tick_t tick;
+
+    tick = rt_tick_get();
+    for (index = 0; index < ID_LOOKUPS; index ++)
+    {
+        seed = seed * 1103515245 + 12345;
+        id = ID_BASE + (seed >> 16) % count;
+
+        if (walk)
+            _get_walk(form, id);
+        else
+            rtgui_container_get_object(form, id);
+    }
+    ms = BENCH_MS_SINCE(tick);
+    if (ms == 0) ms = 1;
+
+    return ID_LOOKUPS / ms;
+}
+
+void bench_object_id(void)
+{
+    int index;
+    struct rtgui_container *form;
+    static const int counts[] = {10, 50, 100, 250, 500};
+
+    rt_kprintf("object lookup by ID (lookups/ms):\n");
+    rt_kprintf("  objects   walk   lookup\n");
+    for (index = 0; index < (int)(sizeof(counts) / sizeof(counts[0])); index ++)
+    {
+        form = _make_form(counts[index]);
+        if (form == RT_NULL)
+            return;
+
+        rt_kprintf("  %7d %6d %8d\n", counts[index],
+                   _lookup_rate(form, counts[index], RT_TRUE),
+                   _lookup_rate(form, counts[index], RT_FALSE));
+        rtgui_container_destroy(form);
+    }
+}
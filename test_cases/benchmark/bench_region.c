@@ -0,0 +1,117 @@
+/*
+ * Region point lookup: points/ms of rtgui_region_contains_point on regions
+ * of 1 to 500 boxes, scanning rows like the point drawing does and at
+ * scattered points, against the old path that walked the boxes linearly.
+ */
+#include <rtgui/region.h>
+
+#include "bench.h"
+
+#define REGION_COLS     25
+#define REGION_BOX      8
+#define REGION_GAP      2
+#define REGION_LOOPS    4
+#define REGION_POINTS   20000
+
+/* the old path: walk the boxes until passing y */
+static int _contains_linear(rtgui_region_t *region, int x, int y, rtgui_rect_t *box)
+{
+    int index, count;
+    rtgui_rect_t *rects;
+
+    count = rtgui_region_num_rects(region);
+    rects = rtgui_region_rects(region);
+    for (index = 0; index < count; index ++)
+    {
+        if (y >= rects[index].y2)
+            continue;
+        if (y < rects[index].y1 || x < rects[index].x1)
+            break;
+        if (x >= rects[index].x2)
+            continue;
+        *box = rects[index];
+        return RT_EOK;
+    }
+
+    return -RT_ERROR;
+}
+
+/* a grid of count boxes, REGION_COLS in a row */
+static void _make_region(rtgui_region_t *region, int count)
+{
+    int index;
+    rtgui_rect_t rect;
+
+    rtgui_region_init(region);
+    for (index = 0; index < count; index ++)
+    {
+        rect.x1 = (index % REGION_COLS) * (REGION_BOX + REGION_GAP);
+        rect.y1 = (index / REGION_COLS) * (REGION_BOX + REGION_GAP);
+        rect.x2 = rect.x1 + REGION_BOX;
+        rect.y2 = rect.y1 + REGION_BOX;
+        rtgui_region_union_rect(region, region, &rect);
+    }
+}
+
+/* points/ms of REGION_POINTS lookups by rows or at scattered points */
+static rt_uint32_t _lookup_rate(rtgui_region_t *region, rt_bool_t linear, rt_bool_t rows)
+{
+    int loop, index, x, y;
+    int width, height;
+    rt_uint32_t seed, ms;
+    rt_tick_t tick;
+    rtgui_rect_t box;
+
+    width = region->extents.x2;
+    height = region->extents.y2;
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < REGION_LOOPS; loop ++)
+    {
+        seed = 1;
+        for (index = 0; index < REGION_POINTS; index ++)
+        {
+            if (rows)
+            {
+                x = index % width;
+                y = (index / width) % height;
+            }
+            else
+            {
+                seed = seed * 1103515245 + 12345;
+                x = (seed >> 8) % width;
+                y = (seed >> 20) % height;
+            }
+
+            if (linear)
+                _contains_linear(region, x, y, &box);
+            else
+                rtgui_region_contains_point(region, x, y, &box);
+        }
+    }
+    ms = BENCH_MS_SINCE(tick);
+    if (ms == 0) ms = 1;
+
+    return (rt_uint32_t)REGION_POINTS * REGION_LOOPS / ms;
+}
+
+void bench_region(void)
+{
+    int index;
+    rtgui_region_t region;
+    static const int counts[] = {1, 10, 50, 100, 250, 500};
+
+    rt_kprintf("region contains_point (points/ms):\n");
+    rt_kprintf("  boxes  rows: linear   band  scattered: linear   band\n");
+    for (index = 0; index < (int)(sizeof(counts) / sizeof(counts[0])); index ++)
+    {
+        _make_region(&region, counts[index]);
+        rt_kprintf("  %5d        %6d %6d             %6d %6d\n",
+                   rtgui_region_num_rects(&region),
+                   _lookup_rate(&region, RT_TRUE, RT_TRUE),
+                   _lookup_rate(&region, RT_FALSE, RT_TRUE),
+                   _lookup_rate(&region, RT_TRUE, RT_FALSE),
+                   _lookup_rate(&region, RT_FALSE, RT_FALSE));
+        rtgui_region_fini(&region);
+    }
+}
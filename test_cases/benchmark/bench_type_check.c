@@ -0,0 +1,65 @@
+/*
+ * Type checks: checks/ms of rtgui_type_inherits_from like RTGUI_IS_WIDGET on
+ * the window and RTGUI_IS_CONTAINER on a label, against the old path that
+ * walked the parents of type.
+ */
+#include <rtgui/rtgui_object.h>
+#include <rtgui/widgets/container.h>
+#include <rtgui/widgets/label.h>
+
+#include "bench.h"
+
+#define TYPE_CHECKS     200000
+
+/* the old path: walk the parents until the root */
+static rt_bool_t _inherits_walk(const rtgui_type_t *type, const rtgui_type_t *parent)
+{
+    for (; type != RT_NULL; type = type->parent)
+    {
+        if (type == parent)
+            return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+/* checks/ms of TYPE_CHECKS checks of type against parent */
+static rt_uint32_t _check_rate(const rtgui_type_t *type, const rtgui_type_t *parent,
+                               rt_bool_t walk)
+{
+    int index;
+    volatile rt_bool_t result;
+    rt_uint32_t ms;
+    rt_tick_t tick;
+
+    tick = rt_tick_get();
+    for (index = 0; index < TYPE_CHECKS; index ++)
+    {
+        if (walk)
+            result = _inherits_walk(type, parent);
+        else
+            result = rtgui_type_inherits_from(type, parent);
+    }
+    ms = BENCH_MS_SINCE(tick);
+    if (ms == 0) ms = 1;
+    (void)result;
+
+    return TYPE_CHECKS / ms;
+}
+
+void bench_type_check(struct rtgui_win *win)
+{
+    const rtgui_type_t *win_type = RTGUI_OBJECT(win)->type;
+
+    rt_kprintf("type check (checks/ms):\n");
+    rt_kprintf("  check                     walk ancestors\n");
+    rt_kprintf("  window is widget      %8d %8d\n",
+               _check_rate(win_type, RTGUI_WIDGET_TYPE, RT_TRUE),
+               _check_rate(win_type, RTGUI_WIDGET_TYPE, RT_FALSE));
+    rt_kprintf("  window is object      %8d %8d\n",
+               _check_rate(win_type, RTGUI_OBJECT_TYPE, RT_TRUE),
+               _check_rate(win_type, RTGUI_OBJECT_TYPE, RT_FALSE));
+    rt_kprintf("  label is container    %8d %8d\n",
+               _check_rate(RTGUI_LABEL_TYPE, RTGUI_CONTAINER_TYPE, RT_TRUE),
+               _check_rate(RTGUI_LABEL_TYPE, RTGUI_CONTAINER_TYPE, RT_FALSE));
+}
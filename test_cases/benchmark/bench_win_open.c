@@ -0,0 +1,173 @@
+/*
+ * Dialog open latency: creating and showing a batch of dialogs one by one
+ * with rtgui_send_sync, and with the async create and show waited once for
+ * the batch. And the cost of the mailbox every synchronous event used to
+ * init and detach, and the region rect arrays allocated in opening and
+ * closing the dialogs.
+ */
+#include <rtgui/region.h>
+#include <rtgui/rtgui_app.h>
+#include <rtgui/rtgui_system.h>
+#include <rtgui/widgets/window.h>
+
+#include "bench.h"
+
+#define OPEN_DIALOGS    4
+#define OPEN_LOOPS      20
+#define MB_LOOPS        10000
+
+static struct rtgui_win *_dialogs[OPEN_DIALOGS];
+
+/* drop the paint events of dialogs, they're destroyed */
+static void _drain_events(void)
+{
+    union rtgui_event_generic event;
+
+    while (rtgui_recv_nosuspend(&event.base, sizeof(event)) == RT_EOK)
+    {
+#ifdef RTGUI_USING_EVENT_POOL
+        if (event.base.type == RTGUI_EVENT_POOLED)
+            rtgui_event_release(event.pooled.event);
+#endif
+    }
+}
+
+static void _close_dialogs(void)
+{
+    int index;
+
+    for (index = 0; index < OPEN_DIALOGS; index ++)
+    {
+        if (_dialogs[index] != RT_NULL)
+            rtgui_win_destroy(_dialogs[index]);
+        _dialogs[index] = RT_NULL;
+    }
+    _drain_events();
+}
+
+static void _dialog_rect(int index, struct rtgui_rect *rect)
+{
+    rect->x1 = 10 + index * 20;
+    rect->y1 = 40 + index * 20;
+    rect->x2 = rect->x1 + 160;
+    rect->y2 = rect->y1 + 100;
+}
+
+/* milliseconds of opening the dialogs OPEN_LOOPS times */
+static rt_uint32_t _open_sync(void)
+{
+    int loop, index;
+    rt_uint32_t ms = 0;
+    rt_tick_t tick;
+    struct rtgui_rect rect;
+
+    for (loop = 0; loop < OPEN_LOOPS; loop ++)
+    {
+        tick = rt_tick_get();
+        for (index = 0; index < OPEN_DIALOGS; index ++)
+        {
+            _dialog_rect(index, &rect);
+            _dialogs[index] = rtgui_win_create(RT_NULL, "dialog", &rect,
+                                               RTGUI_WIN_STYLE_DEFAULT);
+            if (_dialogs[index] != RT_NULL)
+                rtgui_win_show(_dialogs[index], RT_FALSE);
+        }
+        ms += BENCH_MS_SINCE(tick);
+
+        _close_dialogs();
+    }
+
+    return ms;
+}
+
+#ifdef RTGUI_USING_ASYNC_ACK
+static rt_uint32_t _open_async(void)
+{
+    int loop, index;
+    rt_uint32_t ms = 0;
+    rt_tick_t tick;
+    struct rtgui_rect rect;
+
+    for (loop = 0; loop < OPEN_LOOPS; loop ++)
+    {
+        tick = rt_tick_get();
+        for (index = 0; index < OPEN_DIALOGS; index ++)
+        {
+            _dialog_rect(index, &rect);
+            _dialogs[index] = rtgui_win_create_async(RT_NULL, "dialog", &rect,
+                                                     RTGUI_WIN_STYLE_DEFAULT);
+            if (_dialogs[index] != RT_NULL)
+                rtgui_win_show_async(_dialogs[index]);
+        }
+        for (index = 0; index < OPEN_DIALOGS; index ++)
+        {
+            if (_dialogs[index] != RT_NULL)
+                rtgui_win_wait(_dialogs[index]);
+        }
+        ms += BENCH_MS_SINCE(tick);
+
+        _close_dialogs();
+    }
+
+    return ms;
+}
+#endif
+
+/* microseconds of init and detach of an ack mailbox */
+static rt_uint32_t _mailbox_us(void)
+{
+    int loop;
+    rt_tick_t tick;
+    rt_uint32_t ms;
+    rt_uint32_t buffer;
+    struct rt_mailbox mb;
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < MB_LOOPS; loop ++)
+    {
+        rt_mb_init(&mb, "ack", &buffer, 1, 0);
+        rt_mb_detach(&mb);
+    }
+    ms = BENCH_MS_SINCE(tick);
+
+    return ms * 1000 / MB_LOOPS;
+}
+
+#ifdef RTGUI_USING_REGION_POOL
+/* the arrays are counted in server and application both */
+static void _region_allocs(void)
+{
+    rt_uint32_t pooled, heap;
+    struct rtgui_region_pool_stat before, after;
+
+    rtgui_region_get_pool_stat(&before);
+    _open_sync();
+    rtgui_region_get_pool_stat(&after);
+
+    pooled = (after.pooled - before.pooled) / OPEN_LOOPS;
+    heap = (after.heap - before.heap) / OPEN_LOOPS;
+    rt_kprintf("  region rect arrays per loop: %d from heap, %d without pool\n",
+               heap, pooled + heap);
+}
+#endif
+
+void bench_win_open(void)
+{
+    rt_uint32_t ms;
+    rt_uint32_t opened = OPEN_DIALOGS * OPEN_LOOPS;
+
+    rt_kprintf("dialog open, %d dialogs %d loops (ms, us/dialog):\n",
+               OPEN_DIALOGS, OPEN_LOOPS);
+
+    ms = _open_sync();
+    rt_kprintf("  sync  %5d %6d\n", ms, ms * 1000 / opened);
+#ifdef RTGUI_USING_ASYNC_ACK
+    ms = _open_async();
+    rt_kprintf("  async %5d %6d\n", ms, ms * 1000 / opened);
+#endif
+
+    rt_kprintf("  ack mailbox init and detach: %d us\n", _mailbox_us());
+#ifdef RTGUI_USING_REGION_POOL
+    _region_allocs();
+#endif
+}